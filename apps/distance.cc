@@ -0,0 +1,91 @@
+#include "graph_parser.h"
+#include "landmark_index.h"
+#include "task_scheduler.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+//**************************************************************************************************
+// Load the index stored next to the graph file, build and store it if missing
+// or stale
+//**************************************************************************************************
+static GraphError GetIndex(Graph &g, const std::string &path,
+                           TaskScheduler &sched, LandmarkIndex &index) {
+  GraphError ret;
+
+  ret = index.Load(path.c_str(), g);
+  if (ret == kGraphErrorSuccess) {
+    return kGraphErrorSuccess;
+  }
+
+  ret = index.Build(g, sched);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  ret = index.Save(path.c_str());
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Unable to store index " << path << ", ret = " << ret
+              << std::endl;
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  unsigned num_workers = 0;
+  int from, to;
+
+  if (argc < 4) {
+    std::cout << "Usage: distance <input graph file> <from> <to> [num workers]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  from = std::atoi(argv[2]);
+  to = std::atoi(argv[3]);
+  if (argc > 4) {
+    num_workers = std::atoi(argv[4]);
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  {
+    TaskScheduler sched(num_workers);
+
+    for (size_t i = 0; i < graph_vec.size(); i++) {
+      LandmarkIndex index;
+      std::string path = std::string(argv[1]) + "." + std::to_string(i) +
+                         ".pll";
+      int dist;
+
+      ret = GetIndex(*graph_vec[i], path, sched, index);
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "Index build failed with error = " << ret << std::endl;
+        break;
+      }
+
+      ret = index.GetDistance(from, to, &dist);
+      if (ret == kGraphErrorNoPath) {
+        std::cout << "NO PATH." << std::endl;
+        ret = kGraphErrorSuccess;
+      } else if (ret == kGraphErrorSuccess) {
+        std::cout << "DISTANCE " << dist << std::endl;
+      } else {
+        std::cout << "Distance query failed with error = " << ret
+                  << std::endl;
+        break;
+      }
+    }
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
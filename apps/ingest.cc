@@ -0,0 +1,163 @@
+#include "concurrent_graph.h"
+#include "graph_parser.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+//**************************************************************************************************
+// Replay the edges of g into a concurrent graph from writer threads, while
+// reader threads keep running BFS on pinned snapshots
+//**************************************************************************************************
+static GraphError Ingest(Graph &g, int num_writers, int num_readers,
+                         size_t batch, int source) {
+  ConcurrentGraph cg(g.V(), g.isDirected());
+  std::vector<std::pair<int, int>> edges;
+  std::vector<std::thread> writers, readers;
+  std::vector<GraphError> results(num_writers, kGraphErrorSuccess);
+  std::atomic<int> writers_left(num_writers);
+  std::atomic<uint64_t> queries(0), reached(0), regressions(0);
+  std::vector<int> expected, level;
+  CsrGraph csr;
+  GraphError ret;
+
+  // Undirected edges once, InsertEdge() adds the reverse direction
+  ret = csr.Build(g);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  for (int u = 0; u < csr.V(); u++) {
+    for (const int *v = csr.NeighborsBegin(u); v != csr.NeighborsEnd(u); ++v) {
+      if (g.isDirected() || u < *v) {
+        edges.push_back(std::make_pair(u, *v));
+      }
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int w = 0; w < num_writers; w++) {
+    writers.emplace_back([&, w] {
+      size_t queued = 0;
+      for (size_t i = w; i < edges.size(); i += num_writers) {
+        GraphError r = cg.InsertEdge(edges[i].first, edges[i].second);
+        if (r == kGraphErrorSuccess && ++queued % batch == 0) {
+          r = cg.Publish();
+        }
+        if (r != kGraphErrorSuccess) {
+          results[w] = r;
+          break;
+        }
+      }
+      if (results[w] == kGraphErrorSuccess) {
+        results[w] = cg.Publish();
+      }
+      writers_left--;
+    });
+  }
+  for (int r = 0; r < num_readers; r++) {
+    readers.emplace_back([&] {
+      std::vector<int> levels;
+      uint64_t last_version = 0;
+      while (writers_left > 0) {
+        ConcurrentGraph::ReadGuard guard(cg);
+        const GraphSnapshot &snap = guard.Snapshot();
+        if (snap.Version() < last_version) {
+          regressions++;
+        }
+        last_version = snap.Version();
+        if (snap.BfsLevels(source, levels) == kGraphErrorSuccess) {
+          reached += std::count_if(levels.begin(), levels.end(),
+                                   [](int l) { return l >= 0; });
+        }
+        queries++;
+      }
+    });
+  }
+  for (auto &t : writers) {
+    t.join();
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  for (auto &t : readers) {
+    t.join();
+  }
+  for (auto r : results) {
+    if (r != kGraphErrorSuccess) {
+      return r;
+    }
+  }
+
+  // Every edge is published now, the last snapshot must match the graph
+  ConcurrentGraph::ReadGuard guard(cg);
+  const GraphSnapshot &snap = guard.Snapshot();
+  ret = csr.BfsLevels(source, expected);
+  if (ret == kGraphErrorSuccess) {
+    ret = snap.BfsLevels(source, level);
+  }
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+
+  std::cout << "V = " << g.V() << " E = " << g.E() << " INGESTED "
+            << edges.size() << " IN " << seconds << " s ("
+            << (seconds > 0 ? edges.size() / seconds : 0) << " edges/s)"
+            << std::endl;
+  std::cout << "VERSION " << snap.Version() << " BASE EDGES "
+            << snap.Base().E() << " DELTA EDGES " << snap.DeltaEdges()
+            << " DELTA SEGMENTS " << snap.DeltaSegments() << std::endl;
+  std::cout << "READER QUERIES " << queries << " AVG REACHED "
+            << (queries ? reached / queries : 0) << " VERSION REGRESSIONS "
+            << regressions << " FINAL LEVELS "
+            << (level == expected ? "MATCH" : "MISMATCH") << std::endl;
+  return level == expected ? kGraphErrorSuccess : kGraphErrorUnhandled;
+}
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  int num_writers = 2, num_readers = 2, source = 0;
+  size_t batch = 4096;
+
+  if (argc < 2) {
+    std::cout << "Usage: ingest <input graph file> [writers] [readers] "
+                 "[edges per publish] [source]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (argc > 2) {
+    num_writers = std::max(1, std::atoi(argv[2]));
+  }
+  if (argc > 3) {
+    num_readers = std::max(0, std::atoi(argv[3]));
+  }
+  if (argc > 4) {
+    batch = std::max(1, std::atoi(argv[4]));
+  }
+  if (argc > 5) {
+    source = std::atoi(argv[5]);
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  for (auto it : graph_vec) {
+    ret = Ingest(*it, num_writers, num_readers, batch, source);
+    if (ret != kGraphErrorSuccess) {
+      std::cout << "Ingest failed with error = " << ret << std::endl;
+      break;
+    }
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
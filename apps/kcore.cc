@@ -0,0 +1,79 @@
+#include "csr_graph.h"
+#include "degree_stats.h"
+#include "graph_parser.h"
+#include "kcore.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  unsigned num_workers = 0;
+
+  if (argc < 2) {
+    std::cout << "Usage: kcore <input graph file> [num workers]" << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (argc > 2) {
+    num_workers = std::atoi(argv[2]);
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  {
+    TaskScheduler sched(num_workers);
+
+    for (auto it : graph_vec) {
+      DegreeHistogram hist;
+      KCore kc(sched);
+      CsrGraph csr;
+
+      ret = hist.Build(*it, sched);
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "Degree histogram failed with error = " << ret
+                  << std::endl;
+        break;
+      }
+      std::cout << "V = " << it->V() << " E = " << it->E() << " DEGREE MIN "
+                << hist.MinDegree() << " MEDIAN " << hist.Percentile(0.5)
+                << " P99 " << hist.Percentile(0.99) << " MAX "
+                << hist.MaxDegree() << " MEAN " << hist.MeanDegree()
+                << std::endl;
+
+      // Conversion to the dense layout and the peel itself are timed apart
+      auto start = std::chrono::steady_clock::now();
+      ret = csr.BuildUndirectedSimple(*it, &sched);
+      auto built = std::chrono::steady_clock::now();
+      if (ret == kGraphErrorSuccess) {
+        ret = kc.PerformDecomposition(csr);
+      }
+      auto done = std::chrono::steady_clock::now();
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "k-core decomposition failed with error = " << ret
+                  << std::endl;
+        break;
+      }
+
+      double build_seconds =
+          std::chrono::duration<double>(built - start).count();
+      double peel_seconds = std::chrono::duration<double>(done - built).count();
+      std::cout << "MAX CORE " << kc.GetMaxCore() << " CSR EDGES " << csr.E()
+                << " BUILD TIME " << build_seconds << " PEEL TIME "
+                << peel_seconds << " PEEL EDGES/S "
+                << (peel_seconds > 0 ? csr.E() / peel_seconds : 0)
+                << std::endl;
+    }
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
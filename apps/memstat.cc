@@ -0,0 +1,61 @@
+#include "bfs.h"
+#include "compact_graph.h"
+#include "graph_parser.h"
+#include <iostream>
+
+//**************************************************************************************************
+// Print a report and its cost per edge
+//**************************************************************************************************
+static void PrintReport(const MemoryReport &report, size_t num_edges) {
+  std::cout << report;
+  if (num_edges) {
+    std::cout << "  bytes per edge      " << std::setw(14)
+              << (double)report.Total() / num_edges << std::endl;
+  }
+}
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+
+  if (argc < 2) {
+    std::cout << "Usage: memstat <input graph file>" << std::endl;
+    return kGraphErrorBadArgs;
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  for (auto it : graph_vec) {
+    Bfs bfs(*it);
+    CompactGraph compact;
+    size_t num_edges = it->E();
+
+    std::cout << "V = " << it->V() << " E = " << num_edges << std::endl;
+    PrintReport(it->MemoryUsage(), num_edges);
+
+    ret = bfs.PerformSearch();
+    if (ret != kGraphErrorSuccess) {
+      std::cout << "Search failed with error = " << ret << std::endl;
+      break;
+    }
+    PrintReport(bfs.MemoryUsage(), num_edges);
+
+    ret = compact.Build(*it, CompactGraph::kWeight16);
+    if (ret != kGraphErrorSuccess) {
+      std::cout << "Compact layout failed with error = " << ret << std::endl;
+      break;
+    }
+    PrintReport(compact.MemoryUsage(), num_edges);
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
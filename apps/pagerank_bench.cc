@@ -0,0 +1,86 @@
+#include "graph_parser.h"
+#include "pagerank.h"
+#include "simd_gather.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  PageRank::Options opt;
+  unsigned num_workers = 0;
+
+  if (argc < 3) {
+    std::cout << "Usage: pagerank_bench <input graph file> <pull|push|delta> "
+                 "[tolerance] [max iterations] [num workers]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (!strcmp(argv[2], "push")) {
+    opt.mode = PageRank::kModePush;
+  } else if (!strcmp(argv[2], "delta")) {
+    opt.mode = PageRank::kModeDelta;
+  }
+  if (argc > 3) {
+    opt.tolerance = std::atof(argv[3]);
+  }
+  if (argc > 4) {
+    opt.max_iterations = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_workers = std::atoi(argv[5]);
+  }
+
+  auto parse_start = std::chrono::steady_clock::now();
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+  std::cout << "Parse: "
+            << std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             parse_start)
+                   .count()
+            << " s, gather kernel: " << SimdGather::KernelName() << std::endl;
+
+  {
+    TaskScheduler sched(num_workers);
+
+    for (auto it : graph_vec) {
+      PageRank pr(*it, sched);
+      double total = 0, top = 0;
+      int top_id = -1;
+
+      ret = pr.Run(opt);
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "PageRank failed with error = " << ret << std::endl;
+        break;
+      }
+
+      std::cout << "V = " << it->V() << " E = " << it->E() << std::endl;
+      for (auto &s : pr.GetIterationStats()) {
+        std::cout << "ITERATION " << s.iteration << " TIME " << s.seconds
+                  << " RESIDUAL " << s.residual << " ACTIVE " << s.active
+                  << std::endl;
+        total += s.seconds;
+      }
+      for (size_t v = 0; v < pr.GetRanks().size(); v++) {
+        if (pr.GetRanks()[v] > top) {
+          top = pr.GetRanks()[v];
+          top_id = v;
+        }
+      }
+      std::cout << "TOTAL TIME " << total << " TOP VERTEX " << top_id
+                << " RANK " << top << std::endl;
+    }
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
@@ -0,0 +1,68 @@
+#include "graph_parser.h"
+#include "message_transport.h"
+#include "partitioned_bfs.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  PartitionedGraph::Layout layout = PartitionedGraph::kLayout1D;
+  int num_partitions, source;
+
+  if (argc < 5) {
+    std::cout << "Usage: partbfs <input graph file> <partitions> <1d|2d> "
+                 "<source>"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  num_partitions = std::atoi(argv[2]);
+  if (!strcmp(argv[3], "2d")) {
+    layout = PartitionedGraph::kLayout2D;
+  }
+  source = std::atoi(argv[4]);
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  for (auto it : graph_vec) {
+    PartitionedGraph pg;
+    int64_t total_bytes = 0;
+
+    ret = pg.Build(*it, num_partitions, layout);
+    if (ret != kGraphErrorSuccess) {
+      std::cout << "Partitioning failed with error = " << ret << std::endl;
+      break;
+    }
+
+    InProcessTransport transport(pg.NumPartitions());
+    PartitionedBfs bfs(pg, transport);
+
+    ret = bfs.PerformSearch(source);
+    if (ret != kGraphErrorSuccess) {
+      std::cout << "Partitioned search failed with error = " << ret
+                << std::endl;
+      break;
+    }
+
+    std::cout << "GRID " << pg.Rows() << "x" << pg.Cols() << std::endl;
+    for (auto &s : bfs.GetLevelStats()) {
+      std::cout << "LEVEL " << s.level << " FRONTIER " << s.frontier
+                << " MESSAGES " << s.messages << " BYTES " << s.bytes
+                << std::endl;
+      total_bytes += s.bytes;
+    }
+    std::cout << "TOTAL BYTES " << total_bytes << std::endl;
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
@@ -0,0 +1,83 @@
+#include "bfs.h"
+#include "graph_parser.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  Profiler prof;
+  int source = 0;
+  int repeat = 1;
+
+  if (argc < 2) {
+    std::cout << "Usage: profile <input graph file> [source] [repeat]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (argc > 2) {
+    source = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    repeat = std::max(1, std::atoi(argv[3]));
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec, &prof);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  for (auto it : graph_vec) {
+    Graph::VertexListIterator v_it(*it);
+    const Vertex *from = nullptr;
+    size_t path_vertices = 0;
+
+    for (v_it.begin(); !v_it.end(); ++v_it) {
+      if (v_it.getVertex()->getId() == source) {
+        from = v_it.getVertex();
+      }
+    }
+    if (!from) {
+      continue;
+    }
+
+    for (int r = 0; r < repeat; r++) {
+      Bfs bfs(*it);
+
+      {
+        Profiler::Scope scope(&prof, "traverse");
+        ret = bfs.PerformSearch(from);
+      }
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "Search failed with error = " << ret << std::endl;
+        break;
+      }
+
+      // Path from the source to every vertex
+      Profiler::Scope scope(&prof, "path");
+      for (v_it.begin(); !v_it.end(); ++v_it) {
+        std::list<const Vertex *> path;
+        if (bfs.GetPathFromTo(from, v_it.getVertex(), path) ==
+            kGraphErrorSuccess) {
+          path_vertices += path.size();
+        }
+      }
+    }
+    if (ret != kGraphErrorSuccess) {
+      break;
+    }
+    std::cout << "V = " << it->V() << " E = " << it->E() << " PATH VERTICES "
+              << path_vertices << std::endl;
+  }
+
+  prof.Report(std::cout);
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
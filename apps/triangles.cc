@@ -0,0 +1,53 @@
+#include "graph_parser.h"
+#include "simd_intersect.h"
+#include "task_scheduler.h"
+#include "triangle_count.h"
+#include <cstdlib>
+#include <iostream>
+
+//**************************************************************************************************
+// main
+//**************************************************************************************************
+int main(int argc, char **argv) {
+  GraphError ret;
+  std::vector<Graph *> graph_vec;
+  unsigned num_workers = 0;
+
+  if (argc < 2) {
+    std::cout << "Usage: triangles <input graph file> [num workers]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (argc > 2) {
+    num_workers = std::atoi(argv[2]);
+  }
+
+  ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
+  if (ret != kGraphErrorSuccess) {
+    std::cout << "Parsing of Graph Desciprion failed, ret = " << ret
+              << std::endl;
+    return ret;
+  }
+
+  {
+    TaskScheduler sched(num_workers);
+
+    std::cout << "Intersection kernel: " << SimdIntersect::KernelName()
+              << std::endl;
+    for (auto it : graph_vec) {
+      TriangleCount tc(*it, sched);
+
+      ret = tc.PerformCount();
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "Triangle count failed with error = " << ret
+                  << std::endl;
+        break;
+      }
+      std::cout << "TRIANGLES " << tc.GetTriangles() << " AVG CLUSTERING "
+                << tc.GetAverageClustering() << std::endl;
+    }
+  }
+
+  GraphParser::CleanupGraphs(graph_vec);
+  exit(ret);
+}
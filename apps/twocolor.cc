@@ -1,7 +1,17 @@
 #include "bfs.h"
 #include "graph_parser.h"
+#include "parallel_bfs.h"
+#include "task_scheduler.h"
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 
+// Undirected graphs with at least this many edges have their frontier split
+// across the pool instead of being colored by a single task
+static const int kParallelEdgeThreshold = 1 << 16;
+// Vertices checked per task when validating the coloring of a large graph
+static const size_t kEdgeCheckGrain = 1024;
+
 class TwoColor : public Bfs {
 public:
   enum ColorType {
@@ -9,13 +19,7 @@ public:
     kColorTypeBlack = 1,
     kColorTypeWhite = 2,
   };
-  TwoColor(Graph &g) : Bfs(g) {
-    Graph::VertexListIterator v_it(GetGraphInstance());
-
-    for (v_it.begin(); !v_it.end(); ++v_it) {
-      color_map[v_it.getVertex()] = kColorTypeNone;
-    }
-  }
+  TwoColor(Graph &g) : Bfs(g), color_map(g, kColorTypeNone) {}
   GraphError IsBipartite(bool *out);
   ~TwoColor();
 
@@ -31,13 +35,13 @@ private:
     }
     return kColorTypeNone;
   }
-  std::unordered_map<const Vertex *, ColorType> color_map;
+  VertexPropertyMap<ColorType> color_map;
 };
 
 //**************************************************************************************************
 // Destructor
 //**************************************************************************************************
-TwoColor::~TwoColor() { color_map.clear(); }
+TwoColor::~TwoColor() {}
 
 //**************************************************************************************************
 // Plugin to BFS, do pre processing on vertex
@@ -90,6 +94,65 @@ GraphError TwoColor::IsBipartite(bool *out) {
   }
 }
 
+//**************************************************************************************************
+// Bipartite test for large undirected graphs. Levels come from a parallel BFS,
+// the graph is two colorable iff no edge joins two vertices of the same level.
+//**************************************************************************************************
+static GraphError IsBipartiteParallel(Graph &g, TaskScheduler &sched,
+                                      bool *out) {
+  ParallelBfs bfs(g, sched);
+  Graph::VertexListIterator v_it(g);
+  std::vector<const Vertex *> vertices;
+  std::atomic<bool> conflict(false);
+  GraphError ret;
+
+  if (!out) {
+    return kGraphErrorBadArgs;
+  }
+
+  ret = bfs.PerformSearch();
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    vertices.push_back(v_it.getVertex());
+  }
+
+  sched.ParallelFor(0, vertices.size(), kEdgeCheckGrain,
+                    [&](size_t lo, size_t hi) {
+                      for (size_t i = lo; i < hi && !conflict; i++) {
+                        const Vertex *v = vertices[i];
+                        Graph::EdgeListIterator e_it(g, v);
+                        for (e_it.begin(); !e_it.end(); ++e_it) {
+                          const Vertex *neighbor = e_it.getEdge()->getVertex();
+                          // Bfs never reports self loops to ProcessEdge, keep
+                          // the same answer as TwoColor
+                          if (neighbor != v &&
+                              bfs.GetLevel(neighbor) == bfs.GetLevel(v)) {
+                            conflict = true;
+                            break;
+                          }
+                        }
+                      }
+                    });
+
+  *out = !conflict;
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Run the bipartite test of a single graph on the pool
+//**************************************************************************************************
+static GraphError AnalyzeGraph(Graph &g, TaskScheduler &sched, bool *out) {
+  if (!g.isDirected() && g.E() >= kParallelEdgeThreshold) {
+    return IsBipartiteParallel(g, sched, out);
+  }
+
+  TwoColor two_color(g);
+  return two_color.IsBipartite(out);
+}
+
 //**************************************************************************************************
 // main
 //**************************************************************************************************
@@ -97,7 +160,16 @@ GraphError TwoColor::IsBipartite(bool *out) {
 int main(int argc, char **argv) {
   GraphError ret;
   std::vector<Graph *> graph_vec;
-  bool bipartite;
+  unsigned num_workers = 0;
+
+  if (argc < 2) {
+    std::cout << "Usage: twocolor <input graph file> [num workers]"
+              << std::endl;
+    return kGraphErrorBadArgs;
+  }
+  if (argc > 2) {
+    num_workers = std::atoi(argv[2]);
+  }
 
   ret = GraphParser::GetGraphsFromFile(argv[1], graph_vec);
   if (ret != kGraphErrorSuccess) {
@@ -106,23 +178,38 @@ int main(int argc, char **argv) {
     return ret;
   }
 
-  for (auto it : graph_vec) {
-    TwoColor two_color(*it);
-
-    ret = two_color.IsBipartite(&bipartite);
-    if (ret != kGraphErrorSuccess) {
-      std::cout << "Two Color algorithm failed with error = " << ret
-                << std::endl;
-      goto cleanup;
+  {
+    TaskScheduler sched(num_workers);
+    TaskScheduler::TaskGroup group(sched);
+    // Results are gathered per graph and reported in input order
+    std::vector<GraphError> results(graph_vec.size(), kGraphErrorSuccess);
+    std::vector<char> bipartite(graph_vec.size(), 0);
+
+    for (size_t i = 0; i < graph_vec.size(); i++) {
+      group.Submit([&, i] {
+        bool out = false;
+        results[i] = AnalyzeGraph(*graph_vec[i], sched, &out);
+        bipartite[i] = out;
+      });
     }
-
-    if (bipartite) {
-      std::cout << "BICOLORABLE." << std::endl;
-    } else {
-      std::cout << "NOT BICOLORABLE." << std::endl;
+    group.Wait();
+
+    for (size_t i = 0; i < graph_vec.size(); i++) {
+      ret = results[i];
+      if (ret != kGraphErrorSuccess) {
+        std::cout << "Two Color algorithm failed with error = " << ret
+                  << std::endl;
+        break;
+      }
+
+      if (bipartite[i]) {
+        std::cout << "BICOLORABLE." << std::endl;
+      } else {
+        std::cout << "NOT BICOLORABLE." << std::endl;
+      }
     }
   }
-cleanup:
+
   GraphParser::CleanupGraphs(graph_vec);
   exit(ret);
 }
@@ -1,4 +1,5 @@
 #include "graph_type.hpp"
+#include "property_map.h"
 #include <list>
 #include <queue>
 
@@ -19,6 +20,8 @@ public:
   GraphError GetPathFromTo(const Vertex *from, const Vertex *to,
                            std::list<const Vertex *> &out_path);
   virtual ~Bfs();
+  // Bytes held by the search state, excluding the graph
+  MemoryReport MemoryUsage();
 
 protected:
   // plugins to modify breadth first search
@@ -34,11 +37,11 @@ private:
   Bfs(const Bfs &);
   Bfs &operator=(const Bfs &);
   // discovered vertices during search
-  std::unordered_map<const Vertex *, bool> discovered;
+  VertexPropertyMap<bool> discovered;
   // processed vertices
-  std::unordered_map<const Vertex *, bool> processed;
-  // trace parent
-  std::unordered_map<const Vertex *, const Vertex *> parent;
+  VertexPropertyMap<bool> processed;
+  // trace parent, nullptr for search roots and undiscovered vertices
+  VertexPropertyMap<const Vertex *> parent;
   // queue for breadth first search
   std::queue<const Vertex *> search_queue;
   Graph &g;
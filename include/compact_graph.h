@@ -0,0 +1,56 @@
+#include "graph_type.hpp"
+#include <cstdint>
+
+#pragma once
+
+//**************************************************************************************************
+// Read only compact layout of a graph: 32 bit vertex indices in CSR form and
+// optional 16 or 32 bit edge weights stored next to the targets, about 4 to 8
+// bytes per edge against the 100+ of Graph. The vertex index is the vertex id.
+//**************************************************************************************************
+class CompactGraph {
+public:
+  enum WeightType {
+    kWeightNone = 0,
+    kWeight16 = 16,
+    kWeight32 = 32,
+  };
+  CompactGraph() : directed(false), weight_type(kWeightNone), offsets(1, 0) {}
+  // Copy g, weights that do not fit the chosen width fail with
+  // kGraphErrorBadArgs
+  GraphError Build(Graph &g, WeightType w);
+  uint32_t V() const { return (uint32_t)(offsets.size() - 1); }
+  uint64_t E() const { return targets.size(); }
+  bool isDirected() const { return directed; }
+  WeightType getWeightType() const { return weight_type; }
+  uint32_t Degree(uint32_t v) const {
+    return (uint32_t)(offsets[v + 1] - offsets[v]);
+  }
+  // Edges of v are the indices [EdgeBegin(v), EdgeEnd(v)) of the layout
+  uint64_t EdgeBegin(uint32_t v) const { return offsets[v]; }
+  uint64_t EdgeEnd(uint32_t v) const { return offsets[v + 1]; }
+  uint32_t Target(uint64_t e) const { return targets[e]; }
+  // Weight of edge e, 0 without weights
+  int64_t Weight(uint64_t e) const {
+    if (weight_type == kWeight16) {
+      return weights16[e];
+    }
+    if (weight_type == kWeight32) {
+      return weights32[e];
+    }
+    return 0;
+  }
+  // Bytes held per component
+  MemoryReport MemoryUsage() const;
+
+private:
+  bool directed;
+  WeightType weight_type;
+  // start of every adjacency list, V() + 1 entries
+  std::vector<uint64_t> offsets;
+  // concatenated adjacency lists
+  std::vector<uint32_t> targets;
+  // edge weights, only the vector of the chosen width is populated
+  std::vector<int16_t> weights16;
+  std::vector<int32_t> weights32;
+};
@@ -0,0 +1,166 @@
+#include "csr_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#pragma once
+
+//**************************************************************************************************
+// Immutable version of a concurrent graph. Never modified once published.
+// Edges live in a compacted CSR base plus a few sorted delta segments holding
+// the edges published since, all shared with neighbouring snapshots.
+//**************************************************************************************************
+class GraphSnapshot {
+public:
+  // (source, target) pairs sorted by source, then target
+  typedef std::vector<std::pair<int, int>> EdgeList;
+  uint64_t Version() const { return version; }
+  bool isDirected() const { return directed; }
+  int V() const { return base->V(); }
+  size_t E() const { return base->E() + delta_edges; }
+  // Out degree of v, base and delta edges
+  int Degree(int v) const {
+    int degree = base->Degree(v);
+    for (auto &seg : deltas) {
+      auto range = DeltaRange(*seg, v);
+      degree += range.second - range.first;
+    }
+    return degree;
+  }
+  // Call fn(target) for every edge leaving v, base edges first
+  template <typename Fn> void ForEachNeighbor(int v, Fn fn) const {
+    for (const int *u = base->NeighborsBegin(v); u != base->NeighborsEnd(v);
+         ++u) {
+      fn(*u);
+    }
+    for (auto &seg : deltas) {
+      auto range = DeltaRange(*seg, v);
+      for (auto it = range.first; it != range.second; ++it) {
+        fn(it->second);
+      }
+    }
+  }
+  // Hop distance of every vertex from source, -1 when unreachable
+  GraphError BfsLevels(int source, std::vector<int> &out_level) const;
+  // Compacted edges
+  const CsrGraph &Base() const { return *base; }
+  // Edges published since the base was compacted, and the segments they are
+  // spread over
+  size_t DeltaEdges() const { return delta_edges; }
+  size_t DeltaSegments() const { return deltas.size(); }
+
+private:
+  GraphSnapshot(uint64_t ver, bool d)
+      : version(ver), directed(d), delta_edges(0) {}
+  GraphSnapshot(const GraphSnapshot &);
+  GraphSnapshot &operator=(const GraphSnapshot &);
+  static std::pair<EdgeList::const_iterator, EdgeList::const_iterator>
+  DeltaRange(const EdgeList &seg, int v) {
+    return std::equal_range(
+        seg.begin(), seg.end(), std::make_pair(v, 0),
+        [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+          return a.first < b.first;
+        });
+  }
+  uint64_t version;
+  bool directed;
+  std::shared_ptr<const CsrGraph> base;
+  // segments in decreasing size, at most log2 of the delta edges of them
+  std::vector<std::shared_ptr<const EdgeList>> deltas;
+  size_t delta_edges;
+  friend class ConcurrentGraph;
+};
+
+//**************************************************************************************************
+// Graph that keeps serving reads while edges are being ingested. Writers
+// append edges to sharded delta buffers, readers pin the current snapshot
+// with a ReadGuard and never take a lock. Publish() merges the deltas into a
+// new snapshot, swaps it in and frees old snapshots once no reader that
+// could still see them is left (epoch based reclamation).
+// Publishing never copies the base. A batch becomes a new sorted delta
+// segment, and a segment at least as large as the one before it is merged
+// into it, so every edge is merged O(log D) times for the D edges published
+// since the last compaction. Once D exceeds max(kCompactMinEdges,
+// E / kCompactRatio), the segments are folded into a new base in O(V + E),
+// which is O(1) amortized per published edge.
+//**************************************************************************************************
+class ConcurrentGraph {
+public:
+  //************************************************************************************************
+  // Pins the current snapshot for the lifetime of the guard
+  //************************************************************************************************
+  class ReadGuard {
+  public:
+    ReadGuard(ConcurrentGraph &G);
+    ~ReadGuard();
+    const GraphSnapshot &Snapshot() { return *snap; }
+
+  private:
+    ReadGuard(const ReadGuard &);
+    ReadGuard &operator=(const ReadGuard &);
+    ConcurrentGraph &cg;
+    // reader slot holding the epoch this guard entered in
+    int slot;
+    const GraphSnapshot *snap;
+  };
+
+  // Empty graph over vertices [0, n)
+  ConcurrentGraph(int n, bool d);
+  // Initial snapshot copied from g
+  ConcurrentGraph(Graph &g);
+  // No reader may be active anymore
+  ~ConcurrentGraph();
+  // Queue an edge for the next Publish(). Safe from any number of writers.
+  GraphError InsertEdge(int u, int v);
+  // Merge queued edges into a new snapshot and make it current. Returns the
+  // version now visible to readers in out_version when given.
+  GraphError Publish(uint64_t *out_version = nullptr);
+  // Publish with the delta folded into the base regardless of its size
+  GraphError Compact(uint64_t *out_version = nullptr);
+  // Edges queued but not yet published
+  size_t PendingEdges();
+
+  // concurrent ReadGuards supported
+  static const int kMaxReaders = 128;
+  // delta buffers, writers pick one by source vertex
+  static const int kDeltaShards = 16;
+  // published delta edges always tolerated before compacting
+  static const size_t kCompactMinEdges = 1 << 16;
+  // otherwise compact once the delta exceeds 1 / kCompactRatio of the base
+  static const size_t kCompactRatio = 8;
+
+private:
+  ConcurrentGraph(const ConcurrentGraph &);
+  ConcurrentGraph &operator=(const ConcurrentGraph &);
+  void InitSlots();
+  GraphError PublishInternal(bool compact, uint64_t *out_version);
+  void Reclaim();
+  // One per cache line, so readers entering and leaving do not contend
+  struct alignas(64) ReaderSlot {
+    // epoch the reader entered in, 0 when the slot is free
+    std::atomic<uint64_t> epoch;
+  };
+  struct DeltaShard {
+    std::mutex lock;
+    std::vector<std::pair<int, int>> edges;
+  };
+  struct Retired {
+    const GraphSnapshot *snap;
+    // freed once every active reader entered at or after this epoch
+    uint64_t epoch;
+  };
+  int num_nodes;
+  bool directed;
+  // snapshot served to new readers
+  std::atomic<const GraphSnapshot *> current;
+  std::atomic<uint64_t> global_epoch;
+  // kMaxReaders slots, allocated cache line aligned: new does not honour
+  // alignas beyond the default alignment before C++17
+  ReaderSlot *slots;
+  DeltaShard shards[kDeltaShards];
+  // serializes Publish() and owns the retired list
+  std::mutex publish_lock;
+  std::vector<Retired> retired;
+};
@@ -0,0 +1,55 @@
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+#include <utility>
+
+#pragma once
+
+//**************************************************************************************************
+// Dense compressed sparse row copy of a graph. The vertex index is the vertex
+// id, neighbours of v live in Targets()[Offsets()[v], Offsets()[v + 1]).
+//**************************************************************************************************
+class CsrGraph {
+public:
+  CsrGraph() : offsets(1, 0) {}
+  // Copy adjacency of g, every vertex keeps its insertion order
+  GraphError Build(Graph &g);
+  // Undirected simple copy of g: every edge stored in both directions,
+  // adjacency sorted, self loops and repeated edges dropped
+  GraphError BuildUndirectedSimple(Graph &g, TaskScheduler *sched = nullptr);
+  // Build from (source, target) pairs over vertices [0, n)
+  GraphError Build(int n, const std::vector<std::pair<int, int>> &edges);
+  // Copy of base with the (source, target) pairs of delta appended to the
+  // lists of their sources, over max(base.V(), n) vertices
+  GraphError Merge(const CsrGraph &base, int n,
+                   const std::vector<std::pair<int, int>> &delta);
+  // Sort every adjacency list, optionally dropping repeated targets. Lists
+  // are sorted on the scheduler when one is given.
+  void SortAdjacency(bool unique, TaskScheduler *sched = nullptr);
+  int V() const { return (int)offsets.size() - 1; }
+  size_t E() const { return targets.size(); }
+  int Degree(int v) const { return (int)(offsets[v + 1] - offsets[v]); }
+  const int *NeighborsBegin(int v) const {
+    return targets.data() + offsets[v];
+  }
+  const int *NeighborsEnd(int v) const {
+    return targets.data() + offsets[v + 1];
+  }
+  // Hop distance of every vertex from source, -1 when unreachable
+  GraphError BfsLevels(int source, std::vector<int> &out_level) const;
+  // Bytes held per component
+  MemoryReport MemoryUsage() const {
+    MemoryReport report("CsrGraph");
+    report.Add("object", sizeof(CsrGraph));
+    report.Add("offsets", MemoryReport::VectorBytes(offsets));
+    report.Add("targets", MemoryReport::VectorBytes(targets));
+    return report;
+  }
+  const std::vector<size_t> &Offsets() const { return offsets; }
+  const std::vector<int> &Targets() const { return targets; }
+
+private:
+  // start of every adjacency list, V() + 1 entries
+  std::vector<size_t> offsets;
+  // concatenated adjacency lists
+  std::vector<int> targets;
+};
@@ -0,0 +1,43 @@
+#include "csr_graph.h"
+#include "task_scheduler.h"
+#include <cstdint>
+
+#pragma once
+
+//**************************************************************************************************
+// Distribution of vertex degrees, counts[d] is the number of vertices of
+// degree d
+//**************************************************************************************************
+class DegreeHistogram {
+public:
+  DegreeHistogram() : num_vertices(0), num_edges(0) {}
+  // Histogram of the adjacency list lengths of csr
+  GraphError Build(const CsrGraph &csr, TaskScheduler &sched);
+  // Histogram of the out degrees g tracks, over vertex ids [0, V())
+  GraphError Build(Graph &g, TaskScheduler &sched);
+  // Vertices with degree d
+  uint64_t Count(int d) {
+    return (d < 0 || d >= (int)counts.size()) ? 0 : counts[d];
+  }
+  int MinDegree();
+  int MaxDegree() { return counts.empty() ? 0 : (int)counts.size() - 1; }
+  double MeanDegree() {
+    return num_vertices ? (double)num_edges / num_vertices : 0;
+  }
+  // Smallest degree d such that a fraction q of vertices has degree <= d
+  int Percentile(double q);
+  const std::vector<uint64_t> &Counts() { return counts; }
+
+  // vertices counted by a single task
+  static const size_t kVertexGrain = 1 << 16;
+  // degrees below this are counted in task local arrays, the rare larger
+  // ones with atomics
+  static const int kLocalDegrees = 1024;
+
+private:
+  template <typename DegreeFn>
+  void Count(size_t n, const DegreeFn &degree, TaskScheduler &sched);
+  std::vector<uint64_t> counts;
+  uint64_t num_vertices;
+  uint64_t num_edges;
+};
@@ -1,7 +1,10 @@
 #include "graph_type.hpp"
+#include "profiler.h"
 
 namespace GraphParser {
-GraphError GetGraphsFromFile(const char *path,
-                             std::vector<Graph *> &out_graphs);
+// Reading the input is accounted to the "parse" phase of prof, edge insertion
+// to "build"
+GraphError GetGraphsFromFile(const char *path, std::vector<Graph *> &out_graphs,
+                             Profiler *prof = nullptr);
 GraphError CleanupGraphs(std::vector<Graph *> &graphs);
 };
@@ -1,3 +1,4 @@
+#include "memory_usage.h"
 #include <iostream>
 #include <stdexcept>
 #include <unordered_map>
@@ -45,7 +46,7 @@ protected:
 //**************************************************************************************************
 class Edge {
 public:
-  int getWeight() { return weight; }
+  int getWeight() const { return weight; }
   const Vertex *getVertex() const { return end; };
   bool operator<(const Edge &e) { return weight < e.weight; }
 
@@ -112,21 +113,25 @@ public:
   // graph
   class EdgeListIterator {
   public:
-    EdgeListIterator(Graph &G, const Vertex *v) : source(v), g(G) {
+    EdgeListIterator(Graph &G, const Vertex *v)
+        : edges(nullptr), source(v), g(G) {
       if (!v || !g.validVertex(v)) {
         throw std::invalid_argument("Invalid vertex");
       }
     }
-    // Get the begining iterator
+    // Get the begining iterator. The lookup uses at() so that concurrent read
+    // only traversals never modify the adjacency map, and is done once: map
+    // nodes do not move, so the edge list stays put while the map grows.
     EdgeListIterator &begin() {
-      e_it = g.adj_list[source].begin();
+      edges = &g.adj_list.at(source);
+      e_it = edges->begin();
       return *this;
     }
     // Get the end of iteration
-    bool end() { return g.adj_list[source].end() == e_it; }
+    bool end() { return edges->end() == e_it; }
     // Move iterator to next position
     EdgeListIterator &operator++() {
-      if (e_it == g.adj_list[source].end()) {
+      if (e_it == edges->end()) {
         return *this;
       }
       ++e_it;
@@ -134,17 +139,21 @@ public:
     }
     // Get the edge at current iterator position
     const Edge *getEdge() {
-      if (e_it == g.adj_list[source].end()) {
+      if (e_it == edges->end()) {
         throw std::range_error("Attempt to deref empty edge list");
       }
       return *e_it;
     }
+    // Position of the current edge within the edge list of the source
+    size_t getPosition() { return e_it - edges->begin(); }
 
   private:
     friend class Graph;
     // Make constructors private to allow only Graph to create iterator
     // instances
-    EdgeListIterator(Graph &G) : g(G) {}
+    EdgeListIterator(Graph &G) : edges(nullptr), source(nullptr), g(G) {}
+    // Edge list of the source, set by begin()
+    EdgeList *edges;
     // tracking within edgelist
     std::vector<const Edge *>::iterator e_it;
     // The source vertex for which edgelist iterator is created
@@ -154,8 +163,10 @@ public:
   };
   // Graph Constructor
   Graph(int n, bool d)
-      : num_nodes(n), directed(d), edge_list_end(*this),
+      : num_nodes(n), num_edges(0), directed(d), edge_list_end(*this),
         vertex_list_end(*this) {}
+  // Graph owns its vertices and edges
+  ~Graph();
   // Insert Edge variations
   GraphError InsertEdge(const Vertex *u, const Vertex *v, int weight);
   GraphError InsertEdge(const Vertex *u, const Vertex *v);
@@ -167,8 +178,20 @@ public:
     return vertex_list.find(v->getId()) != vertex_list.end();
   }
   bool isDirected() { return directed; }
+  // Number of edges leaving v, undirected edges count for both end points
+  int getDegree(const Vertex *v) {
+    auto it = vertex_degree.find(v);
+    return it == vertex_degree.end() ? 0 : it->second;
+  }
+  // Start of the edges of every vertex id in a dense edge numbering, V() + 1
+  // entries. Edges of a vertex are numbered in edge list order.
+  void GetEdgeOffsets(std::vector<size_t> &out);
+  // Bytes held per component
+  MemoryReport MemoryUsage();
 
 private:
+  Graph(const Graph &);
+  Graph &operator=(const Graph &);
   // number of nodes in the graph
   int num_nodes;
   // number of edges in the graph
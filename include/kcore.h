@@ -0,0 +1,42 @@
+#include "csr_graph.h"
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+
+#pragma once
+
+//**************************************************************************************************
+// k-core decomposition. The core number of v is the largest k such that v
+// belongs to a subgraph in which every vertex has degree >= k. Vertices are
+// peeled in increasing degree order: buckets hold vertices by current degree,
+// and the frontier of the current bucket is peeled in parallel, decrementing
+// neighbour degrees atomically. Edge direction is ignored, self loops and
+// parallel edges are dropped.
+//**************************************************************************************************
+class KCore {
+public:
+  KCore(Graph &g, TaskScheduler &s);
+  // Decomposition of csr only, no Graph needed
+  KCore(TaskScheduler &s);
+  // Decomposition of the graph given at construction
+  GraphError PerformDecomposition();
+  // Decomposition of a graph already in dense form. csr has to be undirected
+  // and simple, as built by CsrGraph::BuildUndirectedSimple().
+  GraphError PerformDecomposition(const CsrGraph &csr);
+  // Core number of v, -1 before PerformDecomposition()
+  int GetCoreNumber(const Vertex *v);
+  int GetMaxCore() { return max_core; }
+  // Core number per vertex id
+  const std::vector<int> &GetCoreNumbers() { return core; }
+  virtual ~KCore() {}
+
+  // frontier vertices peeled by a single task
+  static const size_t kFrontierGrain = 1024;
+
+private:
+  KCore(const KCore &);
+  KCore &operator=(const KCore &);
+  Graph *g;
+  TaskScheduler &sched;
+  std::vector<int> core;
+  int max_core;
+};
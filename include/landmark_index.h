@@ -0,0 +1,91 @@
+#include "csr_graph.h"
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+#include <cstdint>
+
+#pragma once
+
+//**************************************************************************************************
+// 2-hop distance index built with pruned landmark labeling. Vertices are
+// ranked by degree and a pruned BFS is run from each of them in rank order,
+// a vertex only gets a label entry if the labels so far cannot already answer
+// its distance to the root. The hop distance from s to t is then the minimum
+// of d(s, h) + d(h, t) over hubs h common to out label of s and in label of t.
+//**************************************************************************************************
+class LandmarkIndex {
+public:
+  LandmarkIndex()
+      : num_nodes(0), directed(false), num_edges(0), checksum(0) {}
+  // Build the index of g. After the first kSequentialRoots roots, BFS of
+  // kRootBatch roots at a time run in parallel, each pruning against labels
+  // of earlier batches only. That keeps labels exact, at a slightly larger
+  // size than a sequential build.
+  GraphError Build(Graph &g, TaskScheduler &sched);
+  // Hop distance from one vertex to another, kGraphErrorNoPath if unreachable
+  GraphError GetDistance(const Vertex *from, const Vertex *to, int *out);
+  GraphError GetDistance(int from, int to, int *out);
+  // Write index to / read index from a binary file
+  GraphError Save(const char *path);
+  GraphError Load(const char *path);
+  // Read index from a binary file, kGraphErrorUnhandled if it was built from
+  // a graph other than g
+  GraphError Load(const char *path, Graph &g);
+  // Index was built from a graph with the vertex count, direction and edge
+  // list of g. Edge lists are compared through an order independent checksum.
+  bool Matches(Graph &g);
+  int V() { return num_nodes; }
+  bool isDirected() { return directed; }
+  // Total label entries over all vertices
+  size_t LabelEntries() {
+    return out_labels.hubs.size() + (directed ? in_labels.hubs.size() : 0);
+  }
+
+  // Bytes held by the labels
+  MemoryReport MemoryUsage() {
+    MemoryReport report("LandmarkIndex");
+    report.Add("object", sizeof(LandmarkIndex));
+    report.Add("out labels", LabelBytes(out_labels));
+    report.Add("in labels", LabelBytes(in_labels));
+    return report;
+  }
+
+  // highest ranked roots searched one at a time
+  static const int kSequentialRoots = 256;
+  // roots searched concurrently afterwards
+  static const int kRootBatch = 64;
+
+private:
+  // Per vertex labels stored back to back, hubs of a vertex sorted by rank
+  struct Labels {
+    std::vector<uint64_t> offsets;
+    std::vector<int> hubs;
+    std::vector<int> dists;
+  };
+  // Label entries found by the pruned BFS of one root
+  typedef std::vector<std::pair<int, int>> RootLabels;
+  void PrunedBfs(const CsrGraph &csr, int root,
+                 const std::vector<RootLabels> &root_side,
+                 const std::vector<RootLabels> &reach_side,
+                 std::vector<int> &root_dist, std::vector<int> &visit_dist,
+                 RootLabels &out);
+  static size_t LabelBytes(const Labels &l) {
+    return MemoryReport::VectorBytes(l.offsets) +
+           MemoryReport::VectorBytes(l.hubs) +
+           MemoryReport::VectorBytes(l.dists);
+  }
+  static int Query(const Labels &out_side, const Labels &in_side, int from,
+                   int to);
+  static void Flatten(const std::vector<RootLabels> &labels, Labels &out);
+  static GraphError WriteLabels(std::ostream &os, const Labels &l);
+  static GraphError ReadLabels(std::istream &is, int n, Labels &l);
+  static uint64_t EdgeChecksum(Graph &g);
+  int num_nodes;
+  bool directed;
+  // edge count and edge list checksum of the graph the index was built from
+  uint64_t num_edges;
+  uint64_t checksum;
+  // labels for paths leaving a vertex, the only labels if undirected
+  Labels out_labels;
+  // labels for paths entering a vertex, directed graphs only
+  Labels in_labels;
+};
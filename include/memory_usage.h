@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#pragma once
+
+//**************************************************************************************************
+// Bytes held by the components of a data structure. Heap sizes are estimates
+// that include the bookkeeping of a glibc style allocator.
+//**************************************************************************************************
+class MemoryReport {
+public:
+  MemoryReport(const std::string &n) : name(n) {}
+  // Account bytes to a named component
+  void Add(const std::string &component, size_t bytes) {
+    components.push_back(std::make_pair(component, bytes));
+  }
+  size_t Total() const {
+    size_t total = 0;
+    for (auto &c : components) {
+      total += c.second;
+    }
+    return total;
+  }
+  const std::vector<std::pair<std::string, size_t>> &Components() const {
+    return components;
+  }
+  friend std::ostream &operator<<(std::ostream &os, const MemoryReport &r) {
+    os << r.name << std::endl;
+    for (auto &c : r.components) {
+      os << "  " << std::left << std::setw(20) << c.first << std::right
+         << std::setw(14) << c.second << std::endl;
+    }
+    os << "  " << std::left << std::setw(20) << "total" << std::right
+       << std::setw(14) << r.Total() << std::endl;
+    return os;
+  }
+
+  //************************************************************************************************
+  // Estimators
+  //************************************************************************************************
+  // Size of a heap block handed out for a request of n bytes: an 8 byte
+  // header, 16 byte granularity and a 32 byte minimum
+  static size_t HeapBytes(size_t n) {
+    if (!n) {
+      return 0;
+    }
+    size_t chunk = (n + 8 + 15) & ~static_cast<size_t>(15);
+    return chunk < 32 ? 32 : chunk;
+  }
+  // Buffer of a vector
+  template <typename T> static size_t VectorBytes(const std::vector<T> &v) {
+    return HeapBytes(v.capacity() * sizeof(T));
+  }
+  // Bucket array plus one node (next pointer and value) per element
+  template <typename K, typename V>
+  static size_t UnorderedMapBytes(const std::unordered_map<K, V> &m) {
+    return HeapBytes(m.bucket_count() * sizeof(void *)) +
+           m.size() * HeapBytes(sizeof(void *) + sizeof(std::pair<K, V>));
+  }
+  // Deque of size elements: blocks of 512 bytes plus the block map
+  template <typename T> static size_t DequeBytes(size_t size) {
+    size_t per_block = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    size_t blocks = size / per_block + 1;
+    size_t map_size = blocks + 2 < 8 ? 8 : blocks + 2;
+    return blocks * HeapBytes(per_block * sizeof(T)) +
+           HeapBytes(map_size * sizeof(void *));
+  }
+
+private:
+  std::string name;
+  std::vector<std::pair<std::string, size_t>> components;
+};
@@ -0,0 +1,58 @@
+#include "graph_type.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#pragma once
+
+//**************************************************************************************************
+// Transport used by partitions to exchange batches of vertex ids. Batches are
+// tagged so that messages of different supersteps never mix. Every endpoint
+// has to take part in Barrier() and AllReduceSum().
+//**************************************************************************************************
+class MessageTransport {
+public:
+  virtual int NumEndpoints() = 0;
+  // Deliver a batch to endpoint to under tag
+  virtual GraphError Send(int from, int to, int tag,
+                          const std::vector<int> &batch) = 0;
+  // Append every batch delivered to endpoint to under tag to out
+  virtual GraphError Receive(int to, int tag, std::vector<int> &out) = 0;
+  // Block until all endpoints reached the barrier
+  virtual GraphError Barrier(int endpoint) = 0;
+  // Sum of value over all endpoints, also acts as a barrier
+  virtual GraphError AllReduceSum(int endpoint, int64_t value,
+                                  int64_t *out) = 0;
+  virtual ~MessageTransport() {}
+};
+
+//**************************************************************************************************
+// Transport between threads of one process through shared memory mailboxes
+//**************************************************************************************************
+class InProcessTransport : public MessageTransport {
+public:
+  InProcessTransport(int n);
+  int NumEndpoints() { return (int)mailboxes.size(); }
+  GraphError Send(int from, int to, int tag, const std::vector<int> &batch);
+  GraphError Receive(int to, int tag, std::vector<int> &out);
+  GraphError Barrier(int endpoint);
+  GraphError AllReduceSum(int endpoint, int64_t value, int64_t *out);
+
+private:
+  InProcessTransport(const InProcessTransport &);
+  InProcessTransport &operator=(const InProcessTransport &);
+  struct Mailbox {
+    std::mutex lock;
+    std::map<int, std::vector<int>> batches;
+  };
+  std::vector<std::unique_ptr<Mailbox>> mailboxes;
+  // state of the current collective
+  std::mutex collective_lock;
+  std::condition_variable collective_done;
+  int arrived;
+  uint64_t generation;
+  int64_t partial_sum;
+  int64_t result;
+};
@@ -0,0 +1,84 @@
+#include "csr_graph.h"
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+
+#pragma once
+
+//**************************************************************************************************
+// PageRank over a graph, computed with the Spmv kernels on the TaskScheduler.
+// Dangling vertices spread their rank evenly over all vertex ids [0, V()).
+//  - pull: every vertex gathers the contributions of its in neighbours
+//  - push: every vertex scatters its contribution to its out neighbours
+//  - delta: only rank changes above tolerance / V() are pushed, smaller ones
+//    are held back until they grow. Approximate, error bounded by tolerance.
+//**************************************************************************************************
+class PageRank {
+public:
+  enum Mode {
+    kModePull = 0,
+    kModePush = 1,
+    kModeDelta = 2,
+  };
+  struct Options {
+    Options()
+        : mode(kModePull), damping(0.85), tolerance(1e-6),
+          max_iterations(100), warm_start(false) {}
+    Mode mode;
+    double damping;
+    // stop once the L1 norm of the rank change drops below this
+    double tolerance;
+    int max_iterations;
+    // start from the ranks of the previous Run() or SetInitialRanks(), e.g.
+    // after edges were added to the graph. Delta mode then only propagates
+    // the change one iteration over the current graph makes to them.
+    bool warm_start;
+  };
+  struct IterationStats {
+    int iteration;
+    double seconds;
+    // L1 norm of the rank change
+    double residual;
+    // vertices that pushed or gathered in this iteration
+    size_t active;
+  };
+  PageRank(Graph &g, TaskScheduler &s);
+  // Adjacency is rebuilt when the edge count of the graph changed since the
+  // last Run(). Call Rebuild() after edits that keep the edge count.
+  GraphError Run(const Options &opt);
+  void Rebuild() { prepared = false; }
+  // Ranks a warm started Run() begins from, one per vertex id
+  GraphError SetInitialRanks(const std::vector<double> &ranks);
+  // Rank of v, call only after Run()
+  double GetRank(const Vertex *v);
+  const std::vector<double> &GetRanks() { return rank; }
+  const std::vector<IterationStats> &GetIterationStats() { return stats; }
+  virtual ~PageRank() {}
+
+  // vertices handled by a single task
+  static const size_t kVertexGrain = 1024;
+
+private:
+  PageRank(const PageRank &);
+  PageRank &operator=(const PageRank &);
+  GraphError Prepare();
+  double PullIteration(double damping);
+  double PushIteration(double damping);
+  double DeltaIteration(double damping, double threshold, size_t *active);
+  Graph &g;
+  TaskScheduler &sched;
+  bool prepared;
+  // edge count of the graph the adjacency was built from
+  int prepared_edges;
+  CsrGraph out_edges;
+  CsrGraph in_edges;
+  // 1 / out degree, 0 for dangling vertices
+  std::vector<double> inv_degree;
+  std::vector<double> rank;
+  std::vector<double> next;
+  // per vertex scratch: contributions for pull and push, changes for delta
+  std::vector<double> contrib;
+  std::vector<double> delta;
+  // push targets, updated with CAS from concurrent tasks
+  std::unique_ptr<std::atomic<double>[]> acc;
+  std::vector<IterationStats> stats;
+};
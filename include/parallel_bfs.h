@@ -0,0 +1,39 @@
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+#include <atomic>
+
+#pragma once
+
+//**************************************************************************************************
+// Level synchronous breadth first search. Each frontier is split into chunks
+// that are expanded as tasks on a TaskScheduler. Vertex levels are exact,
+// which parent claims a vertex within a level is not deterministic.
+//**************************************************************************************************
+class ParallelBfs {
+public:
+  ParallelBfs(Graph &g, TaskScheduler &s);
+  // search variants, same contract as Bfs
+  GraphError PerformSearch(const Vertex *s);
+  GraphError PerformSearch();
+  // Distance of v from the root of its search tree, -1 if not reached
+  int GetLevel(const Vertex *v);
+  virtual ~ParallelBfs() {}
+  // Bytes held by the search state, excluding the graph
+  MemoryReport MemoryUsage() {
+    MemoryReport report("ParallelBfs");
+    report.Add("object", sizeof(ParallelBfs));
+    report.Add("level", MemoryReport::VectorBytes(level));
+    return report;
+  }
+
+  // frontier vertices handled by a single task
+  static const size_t kFrontierGrain = 512;
+
+private:
+  ParallelBfs(const ParallelBfs &);
+  ParallelBfs &operator=(const ParallelBfs &);
+  // level per vertex id, -1 while undiscovered
+  std::vector<std::atomic<int>> level;
+  Graph &g;
+  TaskScheduler &sched;
+};
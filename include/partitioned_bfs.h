@@ -0,0 +1,45 @@
+#include "message_transport.h"
+#include "partitioned_graph.h"
+
+#pragma once
+
+//**************************************************************************************************
+// Level synchronous BFS over a partitioned graph. Each partition runs on its
+// own thread, standing in for a process, and only talks to the others through
+// the transport. A level has two exchanges: expand sends frontier vertices to
+// the partitions storing their edges, fold sends discovered vertices to their
+// owners. Batches a partition keeps for itself are not sent.
+//**************************************************************************************************
+class PartitionedBfs {
+public:
+  // Communication of one BFS level, summed over partitions
+  struct LevelStats {
+    int level;
+    // vertices in the frontier expanded at this level
+    int64_t frontier;
+    // non empty batches sent to another partition
+    int64_t messages;
+    // payload of those batches
+    int64_t bytes;
+  };
+  // transport needs one endpoint per partition
+  PartitionedBfs(PartitionedGraph &pg, MessageTransport &t);
+  GraphError PerformSearch(int source);
+  // Distance of v from the source, -1 if not reached
+  int GetLevel(int v);
+  const std::vector<LevelStats> &GetLevelStats() { return stats; }
+  virtual ~PartitionedBfs() {}
+
+private:
+  PartitionedBfs(const PartitionedBfs &);
+  PartitionedBfs &operator=(const PartitionedBfs &);
+  GraphError RunPartition(int p, int source);
+  GraphError Exchange(int p, int tag, std::vector<std::vector<int>> &out,
+                      std::vector<int> &in, int64_t &messages,
+                      int64_t &bytes);
+  PartitionedGraph &pg;
+  MessageTransport &transport;
+  // levels of all vertices, each partition writes its owned range only
+  std::vector<int> level;
+  std::vector<LevelStats> stats;
+};
@@ -0,0 +1,61 @@
+#include "graph_type.hpp"
+#include <cstdint>
+
+#pragma once
+
+//**************************************************************************************************
+// Slice of a partitioned graph held by one partition
+//**************************************************************************************************
+struct GraphPartition {
+  // partition id and position in the R x C grid
+  int id;
+  int row;
+  int col;
+  // vertices whose search state this partition owns, [first, last)
+  int owned_first;
+  int owned_last;
+  // sources of the edges stored here, [first, last)
+  int source_first;
+  int source_last;
+  // out edges of source_first + i are targets[offsets[i], offsets[i + 1])
+  std::vector<uint64_t> offsets;
+  std::vector<int> targets;
+};
+
+//**************************************************************************************************
+// Vertex partitioned graph. Vertices are split into contiguous blocks, one
+// per partition. Partitions form an R x C grid numbered column major, the
+// edge (u, v) is stored by the partition in the column of the owner of u and
+// in the row of the owner of v. 1D layout is the R = 1 case where a partition
+// stores all out edges of the vertices it owns. With a 2D layout a frontier
+// vertex is only sent along its grid column and discovered vertices only
+// along a grid row.
+//**************************************************************************************************
+class PartitionedGraph {
+public:
+  enum Layout {
+    kLayout1D = 1,
+    kLayout2D = 2,
+  };
+  PartitionedGraph() : num_nodes(0), rows(1), cols(1), block(1) {}
+  // Split g over num_partitions partitions. For kLayout2D the grid is the
+  // most square factorization of num_partitions.
+  GraphError Build(Graph &g, int num_partitions, Layout layout);
+  int V() { return num_nodes; }
+  int NumPartitions() { return (int)partitions.size(); }
+  int Rows() { return rows; }
+  int Cols() { return cols; }
+  // Partition owning vertex v
+  int Owner(int v) { return v / block; }
+  // Partition at grid position (row, col)
+  int At(int row, int col) { return col * rows + row; }
+  GraphPartition &GetPartition(int p) { return partitions[p]; }
+
+private:
+  int num_nodes;
+  int rows;
+  int cols;
+  // vertices per partition
+  int block;
+  std::vector<GraphPartition> partitions;
+};
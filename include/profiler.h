@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#pragma once
+
+//**************************************************************************************************
+// Hardware counters of the calling thread, opened with perf_event_open on
+// Linux. Counters the kernel or the machine does not provide (containers, VMs,
+// perf_event_paranoid, other platforms) are reported unavailable; Read() still
+// succeeds for the others. Threads other than the opener are not counted.
+//**************************************************************************************************
+class PerfCounters {
+public:
+  enum Event {
+    kEventCycles = 0,
+    kEventInstructions = 1,
+    kEventLlcMisses = 2,
+    kEventBranchMisses = 3,
+    kNumEvents = 4,
+  };
+  struct Sample {
+    // counts since open, scaled up if the kernel multiplexed the counter
+    uint64_t value[kNumEvents];
+    bool valid[kNumEvents];
+  };
+  PerfCounters();
+  ~PerfCounters();
+  bool Available(Event e) { return fds[e] >= 0; }
+  bool AnyAvailable();
+  void Read(Sample *out);
+  // Why the first unavailable counter could not be opened
+  const std::string &Error() { return error; }
+  static const char *EventName(Event e);
+
+private:
+  PerfCounters(const PerfCounters &);
+  PerfCounters &operator=(const PerfCounters &);
+  int fds[kNumEvents];
+  std::string error;
+};
+
+//**************************************************************************************************
+// Per phase wall time and hardware counter totals. Profiling is opt-in: code
+// takes a Profiler pointer and opens a Scope around each phase, a null
+// profiler turns the scopes into no-ops. Nested scopes are inclusive.
+//**************************************************************************************************
+class Profiler {
+public:
+  struct PhaseStats {
+    std::string name;
+    uint64_t calls;
+    double seconds;
+    uint64_t counters[PerfCounters::kNumEvents];
+    bool valid[PerfCounters::kNumEvents];
+  };
+
+  //************************************************************************************************
+  // Attributes the time and counters between construction and destruction to
+  // a phase
+  //************************************************************************************************
+  class Scope {
+  public:
+    Scope(Profiler *p, const char *phase);
+    ~Scope();
+
+  private:
+    Scope(const Scope &);
+    Scope &operator=(const Scope &);
+    Profiler *prof;
+    size_t phase;
+    std::chrono::steady_clock::time_point start_time;
+    PerfCounters::Sample start;
+  };
+
+  Profiler() {}
+  const std::vector<PhaseStats> &Phases() { return phases; }
+  PerfCounters &Counters() { return counters; }
+  // Table of the phases in first use order, with instructions per cycle and
+  // misses per thousand instructions where the counters allow
+  void Report(std::ostream &os);
+
+private:
+  Profiler(const Profiler &);
+  Profiler &operator=(const Profiler &);
+  size_t GetPhase(const char *name);
+  PerfCounters counters;
+  std::vector<PhaseStats> phases;
+};
@@ -0,0 +1,68 @@
+#include "graph_type.hpp"
+#include <algorithm>
+#include <memory>
+
+#pragma once
+
+//**************************************************************************************************
+// Dense per vertex property, one contiguous array per property indexed by
+// vertex id. Copies share the same storage, so a map can be handed from one
+// algorithm to the next without copying or hashing.
+//**************************************************************************************************
+template <typename T> class VertexPropertyMap {
+public:
+  VertexPropertyMap() : size(0) {}
+  // One slot per vertex id of g, all set to init
+  VertexPropertyMap(Graph &g, const T &init = T()) : size(0) {
+    Allocate(g.V(), init);
+  }
+  // (Re)allocate n slots set to init
+  void Allocate(size_t n, const T &init = T()) {
+    values.reset(new T[n], std::default_delete<T[]>());
+    size = n;
+    Reset(init);
+  }
+  // Set every slot to init
+  void Reset(const T &init = T()) { std::fill(Data(), Data() + size, init); }
+  T &operator[](const Vertex *v) { return values.get()[v->getId()]; }
+  T &operator[](size_t idx) { return values.get()[idx]; }
+  T *Data() { return values.get(); }
+  size_t Size() const { return size; }
+  size_t Bytes() const { return MemoryReport::HeapBytes(size * sizeof(T)); }
+
+private:
+  std::shared_ptr<T> values;
+  size_t size;
+};
+
+//**************************************************************************************************
+// Dense per edge property. Edges of vertex v occupy the slots starting at
+// Graph::GetEdgeOffsets()[v], in the order EdgeListIterator visits them.
+//**************************************************************************************************
+template <typename T> class EdgePropertyMap {
+public:
+  EdgePropertyMap() {}
+  // One slot per edge of g, all set to init
+  EdgePropertyMap(Graph &g, const T &init = T()) { Allocate(g, init); }
+  void Allocate(Graph &g, const T &init = T()) {
+    offsets = std::make_shared<std::vector<size_t>>();
+    g.GetEdgeOffsets(*offsets);
+    values.Allocate(offsets->back(), init);
+  }
+  void Reset(const T &init = T()) { values.Reset(init); }
+  // Property of the edge at position pos of the edge list of v
+  T &operator()(const Vertex *v, size_t pos) {
+    return values[(*offsets)[v->getId()] + pos];
+  }
+  T &operator[](size_t idx) { return values[idx]; }
+  T *Data() { return values.Data(); }
+  size_t Size() const { return values.Size(); }
+  size_t Bytes() const {
+    return values.Bytes() +
+           (offsets ? MemoryReport::VectorBytes(*offsets) : 0);
+  }
+
+private:
+  std::shared_ptr<std::vector<size_t>> offsets;
+  VertexPropertyMap<T> values;
+};
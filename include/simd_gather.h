@@ -0,0 +1,56 @@
+#include <cstddef>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#pragma once
+
+//**************************************************************************************************
+// Sum of x[idx[0]] .. x[idx[n - 1]], the inner loop of a pull style sparse
+// matrix vector product. Uses AVX2 gathers when the target supports them,
+// otherwise a scalar loop with independent accumulators.
+//**************************************************************************************************
+namespace SimdGather {
+
+// Name of the kernel compiled in, for reporting
+inline const char *KernelName() {
+#if defined(__AVX2__)
+  return "avx2";
+#else
+  return "scalar";
+#endif
+}
+
+inline double GatherSum(const double *x, const int *idx, size_t n) {
+  size_t i = 0;
+  double sum = 0;
+
+#if defined(__AVX2__)
+  __m256d acc = _mm256_setzero_pd();
+  for (; i + 4 <= n; i += 4) {
+    // go through void to keep -Wcast-align quiet on unaligned loads
+    __m128i vi = _mm_loadu_si128(
+        static_cast<const __m128i *>(static_cast<const void *>(idx + i)));
+    acc = _mm256_add_pd(acc, _mm256_i32gather_pd(x, vi, sizeof(double)));
+  }
+  __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc),
+                            _mm256_extractf128_pd(acc, 1));
+  sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+#else
+  double acc[4] = {0, 0, 0, 0};
+  for (; i + 4 <= n; i += 4) {
+    acc[0] += x[idx[i]];
+    acc[1] += x[idx[i + 1]];
+    acc[2] += x[idx[i + 2]];
+    acc[3] += x[idx[i + 3]];
+  }
+  sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+
+  for (; i < n; i++) {
+    sum += x[idx[i]];
+  }
+  return sum;
+}
+
+} // namespace SimdGather
@@ -0,0 +1,107 @@
+#include <cstddef>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#pragma once
+
+//**************************************************************************************************
+// Merge intersection of sorted, duplicate free int arrays. Blocks of both
+// inputs are compared all against all with AVX2 (8x8) or SSE2 (4x4) when the
+// target supports it, the remaining tails are merged with scalar code.
+//**************************************************************************************************
+namespace SimdIntersect {
+
+// Name of the kernel compiled in, for reporting
+inline const char *KernelName() {
+#if defined(__AVX2__)
+  return "avx2";
+#elif defined(__SSE2__)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+//**************************************************************************************************
+// Call visit(x) for every x in both a and b, in increasing order. Returns the
+// number of common elements.
+//**************************************************************************************************
+template <typename Visitor>
+size_t Intersect(const int *a, size_t na, const int *b, size_t nb,
+                 Visitor visit) {
+  size_t i = 0, j = 0, count = 0;
+
+#if defined(__AVX2__)
+  const __m256i rot = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  while (i + 8 <= na && j + 8 <= nb) {
+    // go through void to keep -Wcast-align quiet on unaligned loads
+    __m256i va = _mm256_loadu_si256(
+        static_cast<const __m256i *>(static_cast<const void *>(a + i)));
+    __m256i vb = _mm256_loadu_si256(
+        static_cast<const __m256i *>(static_cast<const void *>(b + j)));
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+    for (int r = 1; r < 8; r++) {
+      vb = _mm256_permutevar8x32_epi32(vb, rot);
+      eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+    }
+    unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    count += __builtin_popcount(mask);
+    while (mask) {
+      visit(a[i + __builtin_ctz(mask)]);
+      mask &= mask - 1;
+    }
+    int a_max = a[i + 7], b_max = b[j + 7];
+    i += (a_max <= b_max) ? 8 : 0;
+    j += (b_max <= a_max) ? 8 : 0;
+  }
+#elif defined(__SSE2__)
+  while (i + 4 <= na && j + 4 <= nb) {
+    // go through void to keep -Wcast-align quiet on unaligned loads
+    __m128i va = _mm_loadu_si128(
+        static_cast<const __m128i *>(static_cast<const void *>(a + i)));
+    __m128i vb = _mm_loadu_si128(
+        static_cast<const __m128i *>(static_cast<const void *>(b + j)));
+    __m128i eq = _mm_cmpeq_epi32(va, vb);
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+    unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+    count += __builtin_popcount(mask);
+    while (mask) {
+      visit(a[i + __builtin_ctz(mask)]);
+      mask &= mask - 1;
+    }
+    int a_max = a[i + 3], b_max = b[j + 3];
+    i += (a_max <= b_max) ? 4 : 0;
+    j += (b_max <= a_max) ? 4 : 0;
+  }
+#endif
+
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      i++;
+    } else if (b[j] < a[i]) {
+      j++;
+    } else {
+      visit(a[i]);
+      count++;
+      i++;
+      j++;
+    }
+  }
+  return count;
+}
+
+//**************************************************************************************************
+// Number of common elements of a and b
+//**************************************************************************************************
+inline size_t IntersectCount(const int *a, size_t na, const int *b,
+                             size_t nb) {
+  return Intersect(a, na, b, nb, [](int) {});
+}
+
+} // namespace SimdIntersect
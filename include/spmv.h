@@ -0,0 +1,30 @@
+#include "csr_graph.h"
+#include "task_scheduler.h"
+#include <atomic>
+
+#pragma once
+
+//**************************************************************************************************
+// Sparse matrix vector products over the adjacency of a CsrGraph, seen as a
+// 0/1 matrix whose row v holds the neighbours of v. Rows are processed in
+// parallel on the scheduler.
+//**************************************************************************************************
+namespace Spmv {
+
+// rows handled by a single task
+static const size_t kRowGrain = 1024;
+
+// y[v] = sum of x[u] over the neighbours u of v
+void Pull(const CsrGraph &a, const double *x, double *y, TaskScheduler &sched);
+// y[v] += x[u] for every neighbour v of u. Rows with x[u] == 0 are skipped.
+void Push(const CsrGraph &a, const double *x, std::atomic<double> *y,
+          TaskScheduler &sched);
+
+// Add v to a with a CAS loop
+inline void AtomicAdd(std::atomic<double> &a, double v) {
+  double old = a.load(std::memory_order_relaxed);
+  while (!a.compare_exchange_weak(old, old + v, std::memory_order_relaxed)) {
+  }
+}
+
+} // namespace Spmv
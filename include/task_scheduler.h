@@ -0,0 +1,81 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#pragma once
+
+//**************************************************************************************************
+// Work stealing task scheduler. Every worker owns a deque, it pushes and pops
+// its own work at the back while idle workers steal from the front of others.
+//**************************************************************************************************
+class TaskScheduler {
+public:
+  typedef std::function<void()> Task;
+
+  //************************************************************************************************
+  // Set of tasks that can be waited upon as a unit
+  //************************************************************************************************
+  class TaskGroup {
+  public:
+    TaskGroup(TaskScheduler &s) : sched(s), pending(0) {}
+    // Queue a task on the scheduler as part of this group
+    void Submit(Task task);
+    // Block until every task of the group finished. The calling thread runs
+    // queued tasks meanwhile, so waiting from inside a task does not deadlock.
+    void Wait();
+    ~TaskGroup() { Wait(); }
+
+  private:
+    TaskGroup(const TaskGroup &);
+    TaskGroup &operator=(const TaskGroup &);
+    void TaskDone();
+    TaskScheduler &sched;
+    // tasks submitted but not yet finished
+    std::atomic<int> pending;
+    // wakes up a waiter once pending drops to zero
+    std::mutex done_lock;
+    std::condition_variable done;
+    friend class TaskScheduler;
+  };
+
+  // Create scheduler with num_workers threads, 0 picks hardware concurrency
+  TaskScheduler(unsigned num_workers = 0);
+  ~TaskScheduler();
+  unsigned NumWorkers() { return workers.size(); }
+  // Split [begin, end) into chunks of at most grain items and run fn(lo, hi)
+  // for each chunk on the pool. Returns once all chunks are done.
+  void ParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)> &fn);
+
+private:
+  TaskScheduler(const TaskScheduler &);
+  TaskScheduler &operator=(const TaskScheduler &);
+  struct QueuedTask {
+    Task fn;
+    TaskGroup *group;
+  };
+  struct WorkQueue {
+    std::mutex lock;
+    std::deque<QueuedTask> tasks;
+  };
+  void Push(QueuedTask &&t);
+  bool Pop(QueuedTask &out);
+  bool RunOne();
+  void WorkerLoop(unsigned idx);
+  // one deque per worker
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+  // number of tasks sitting in any deque
+  std::atomic<int> queued;
+  // round robin slot for tasks submitted from outside the pool
+  std::atomic<unsigned> next_queue;
+  // idle workers sleep here
+  std::mutex sleep_lock;
+  std::condition_variable wake;
+  bool stop;
+};
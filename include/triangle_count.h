@@ -0,0 +1,45 @@
+#include "graph_type.hpp"
+#include "task_scheduler.h"
+#include <cstdint>
+
+#pragma once
+
+//**************************************************************************************************
+// Triangle counting and local clustering coefficient. Vertices are ranked by
+// degree and every edge is oriented towards the higher rank, so each triangle
+// is found exactly once by intersecting the sorted out lists of its lowest
+// edge. Edge direction is ignored, self loops and parallel edges are dropped.
+//**************************************************************************************************
+class TriangleCount {
+public:
+  TriangleCount(Graph &g, TaskScheduler &s);
+  // Count triangles, per vertex counts and clustering coefficients
+  GraphError PerformCount();
+  // Triangles in the whole graph. Call only after PerformCount().
+  uint64_t GetTriangles() { return total; }
+  // Triangles containing v
+  uint64_t GetTriangles(const Vertex *v);
+  // Fraction of neighbour pairs of v that are adjacent, 0 for degree < 2
+  double GetClusteringCoefficient(const Vertex *v);
+  // Mean clustering coefficient over the vertices of the graph
+  double GetAverageClustering() { return avg_clustering; }
+  virtual ~TriangleCount() {}
+
+  // ranked vertices whose out lists are intersected by a single task
+  static const size_t kVertexGrain = 256;
+
+private:
+  TriangleCount(const TriangleCount &);
+  TriangleCount &operator=(const TriangleCount &);
+  bool InRange(const Vertex *v) {
+    return v && v->getId() >= 0 && v->getId() < (int)triangles.size();
+  }
+  Graph &g;
+  TaskScheduler &sched;
+  // triangles per vertex id
+  std::vector<uint64_t> triangles;
+  // undirected simple degree per vertex id
+  std::vector<int> degree;
+  uint64_t total;
+  double avg_clustering;
+};
@@ -4,16 +4,8 @@
 //**************************************************************************************************
 // Construct BFS for a given a graph instance
 //**************************************************************************************************
-Bfs::Bfs(Graph &G) : g(G) {
-  Graph::VertexListIterator v_it(G);
-  const Vertex *curr_vertex;
-
-  for (v_it.begin(); !v_it.end(); ++v_it) {
-    curr_vertex = v_it.getVertex();
-    discovered.insert(std::make_pair(curr_vertex, false));
-    processed.insert(std::make_pair(curr_vertex, false));
-    parent.insert(std::make_pair(curr_vertex, curr_vertex));
-  }
+Bfs::Bfs(Graph &G)
+    : discovered(G, false), processed(G, false), parent(G, nullptr), g(G) {
   this->terminate = false;
 }
 
@@ -21,9 +13,6 @@ Bfs::Bfs(Graph &G) : g(G) {
 // Destructor
 //**************************************************************************************************
 Bfs::~Bfs() {
-  discovered.clear();
-  processed.clear();
-  parent.clear();
   while (!search_queue.empty()) {
     search_queue.pop();
   }
@@ -123,7 +112,7 @@ GraphError Bfs::GetPathFromTo(const Vertex *from, const Vertex *to,
     return kGraphErrorBadArgs;
   }
 
-  if (parent.empty()) {
+  if (!parent.Size()) {
     return kGraphErrorNoPath;
   }
 
@@ -132,10 +121,25 @@ GraphError Bfs::GetPathFromTo(const Vertex *from, const Vertex *to,
     return kGraphErrorSuccess;
   }
 
-  if (parent[to] == to) {
+  if (!parent[to]) {
     return kGraphErrorNoPath;
   }
 
   out_path.push_front(to);
   return GetPathFromTo(from, parent[to], out_path);
 }
+
+//**************************************************************************************************
+// Memory held by the search state
+//**************************************************************************************************
+MemoryReport Bfs::MemoryUsage() {
+  MemoryReport report("Bfs");
+
+  report.Add("object", sizeof(Bfs));
+  report.Add("discovered", discovered.Bytes());
+  report.Add("processed", processed.Bytes());
+  report.Add("parent", parent.Bytes());
+  report.Add("search_queue",
+             MemoryReport::DequeBytes<const Vertex *>(search_queue.size()));
+  return report;
+}
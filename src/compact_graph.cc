@@ -0,0 +1,72 @@
+#include "compact_graph.h"
+#include <limits>
+
+//**************************************************************************************************
+// Build compact copy of a graph
+//**************************************************************************************************
+GraphError CompactGraph::Build(Graph &g, WeightType w) {
+  Graph::VertexListIterator v_it(g);
+  std::vector<uint64_t> fill;
+  uint32_t n;
+
+  if (g.V() < 0 || (w != kWeightNone && w != kWeight16 && w != kWeight32)) {
+    return kGraphErrorBadArgs;
+  }
+
+  n = g.V();
+  directed = g.isDirected();
+  weight_type = w;
+
+  // Degrees first, so every array is allocated exactly once
+  offsets.assign(n + 1, 0);
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      offsets[v->getId() + 1]++;
+    }
+  }
+  for (uint32_t v = 0; v < n; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+
+  targets.assign(offsets[n], 0);
+  weights16.assign(w == kWeight16 ? offsets[n] : 0, 0);
+  weights32.assign(w == kWeight32 ? offsets[n] : 0, 0);
+  fill.assign(offsets.begin(), offsets.end() - 1);
+
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      const Edge *e = e_it.getEdge();
+      uint64_t pos = fill[v->getId()]++;
+
+      targets[pos] = e->getVertex()->getId();
+      if (w == kWeight16) {
+        if (e->getWeight() < std::numeric_limits<int16_t>::min() ||
+            e->getWeight() > std::numeric_limits<int16_t>::max()) {
+          return kGraphErrorBadArgs;
+        }
+        weights16[pos] = e->getWeight();
+      } else if (w == kWeight32) {
+        weights32[pos] = e->getWeight();
+      }
+    }
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Memory held by the layout
+//**************************************************************************************************
+MemoryReport CompactGraph::MemoryUsage() const {
+  MemoryReport report("CompactGraph");
+
+  report.Add("object", sizeof(CompactGraph));
+  report.Add("offsets", MemoryReport::VectorBytes(offsets));
+  report.Add("targets", MemoryReport::VectorBytes(targets));
+  report.Add("weights", MemoryReport::VectorBytes(weights16) +
+                            MemoryReport::VectorBytes(weights32));
+  return report;
+}
@@ -0,0 +1,275 @@
+#include "concurrent_graph.h"
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+//**************************************************************************************************
+// Breadth first levels over base and delta edges
+//**************************************************************************************************
+GraphError GraphSnapshot::BfsLevels(int source,
+                                    std::vector<int> &out_level) const {
+  std::vector<int> frontier, next;
+  int curr_level = 0;
+
+  if (source < 0 || source >= V()) {
+    return kGraphErrorBadArgs;
+  }
+
+  out_level.assign(V(), -1);
+  out_level[source] = 0;
+  frontier.push_back(source);
+
+  while (!frontier.empty()) {
+    next.clear();
+    for (int v : frontier) {
+      ForEachNeighbor(v, [&](int u) {
+        if (out_level[u] < 0) {
+          out_level[u] = curr_level + 1;
+          next.push_back(u);
+        }
+      });
+    }
+    frontier.swap(next);
+    curr_level++;
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Enter the current epoch and pin the current snapshot
+//**************************************************************************************************
+ConcurrentGraph::ReadGuard::ReadGuard(ConcurrentGraph &G) : cg(G), slot(-1) {
+  std::hash<std::thread::id> hasher;
+  int start = hasher(std::this_thread::get_id()) % kMaxReaders;
+
+  // Claim a free slot, marking it with the epoch we enter in. All accesses
+  // are sequentially consistent: a publisher either sees this slot or the
+  // snapshot loaded below is already the one it published.
+  while (slot < 0) {
+    for (int i = 0; i < kMaxReaders; i++) {
+      int idx = (start + i) % kMaxReaders;
+      uint64_t expected = 0;
+      if (cg.slots[idx].epoch.compare_exchange_strong(expected,
+                                                      cg.global_epoch)) {
+        slot = idx;
+        break;
+      }
+    }
+    if (slot < 0) {
+      std::this_thread::yield();
+    }
+  }
+  snap = cg.current.load();
+}
+
+//**************************************************************************************************
+// Leave the epoch, the snapshot may be reclaimed afterwards
+//**************************************************************************************************
+ConcurrentGraph::ReadGuard::~ReadGuard() { cg.slots[slot].epoch.store(0); }
+
+//**************************************************************************************************
+// Allocate free reader slots
+//**************************************************************************************************
+void ConcurrentGraph::InitSlots() {
+  void *mem = nullptr;
+
+  if (posix_memalign(&mem, alignof(ReaderSlot),
+                     kMaxReaders * sizeof(ReaderSlot))) {
+    throw std::bad_alloc();
+  }
+  slots = static_cast<ReaderSlot *>(mem);
+  for (int i = 0; i < kMaxReaders; i++) {
+    new (&slots[i]) ReaderSlot();
+    slots[i].epoch.store(0);
+  }
+}
+
+//**************************************************************************************************
+// Construct empty concurrent graph
+//**************************************************************************************************
+ConcurrentGraph::ConcurrentGraph(int n, bool d)
+    : num_nodes(n), directed(d), global_epoch(1) {
+  GraphSnapshot *snap = new GraphSnapshot(0, d);
+  std::shared_ptr<CsrGraph> base = std::make_shared<CsrGraph>();
+  std::vector<std::pair<int, int>> none;
+
+  base->Build(n, none);
+  snap->base = base;
+  InitSlots();
+  current.store(snap);
+}
+
+//**************************************************************************************************
+// Construct concurrent graph seeded from a graph instance
+//**************************************************************************************************
+ConcurrentGraph::ConcurrentGraph(Graph &g)
+    : num_nodes(g.V()), directed(g.isDirected()), global_epoch(1) {
+  GraphSnapshot *snap = new GraphSnapshot(0, g.isDirected());
+  std::shared_ptr<CsrGraph> base = std::make_shared<CsrGraph>();
+
+  base->Build(g);
+  snap->base = base;
+  InitSlots();
+  current.store(snap);
+}
+
+//**************************************************************************************************
+// Destructor
+//**************************************************************************************************
+ConcurrentGraph::~ConcurrentGraph() {
+  for (auto &r : retired) {
+    delete r.snap;
+  }
+  retired.clear();
+  delete current.load();
+  free(slots);
+}
+
+//**************************************************************************************************
+// Queue an edge
+//**************************************************************************************************
+GraphError ConcurrentGraph::InsertEdge(int u, int v) {
+  if (u < 0 || u >= num_nodes || v < 0 || v >= num_nodes) {
+    return kGraphErrorBadArgs;
+  }
+
+  DeltaShard &shard = shards[u % kDeltaShards];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  shard.edges.push_back(std::make_pair(u, v));
+  if (!directed) {
+    shard.edges.push_back(std::make_pair(v, u));
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Number of queued edges
+//**************************************************************************************************
+size_t ConcurrentGraph::PendingEdges() {
+  size_t n = 0;
+
+  for (auto &shard : shards) {
+    std::lock_guard<std::mutex> guard(shard.lock);
+    n += shard.edges.size();
+  }
+  return n;
+}
+
+//**************************************************************************************************
+// Publish queued edges
+//**************************************************************************************************
+GraphError ConcurrentGraph::Publish(uint64_t *out_version) {
+  return PublishInternal(false, out_version);
+}
+
+//**************************************************************************************************
+// Publish queued edges and fold every delta into the base
+//**************************************************************************************************
+GraphError ConcurrentGraph::Compact(uint64_t *out_version) {
+  return PublishInternal(true, out_version);
+}
+
+//**************************************************************************************************
+// Add queued edges to the deltas of a new snapshot and publish it
+//**************************************************************************************************
+GraphError ConcurrentGraph::PublishInternal(bool compact,
+                                           uint64_t *out_version) {
+  std::lock_guard<std::mutex> guard(publish_lock);
+  std::shared_ptr<GraphSnapshot::EdgeList> delta =
+      std::make_shared<GraphSnapshot::EdgeList>();
+  const GraphSnapshot *old = current.load();
+  GraphSnapshot *next;
+
+  // Take the buffers over, writers continue into empty ones
+  for (auto &shard : shards) {
+    std::vector<std::pair<int, int>> edges;
+    {
+      std::lock_guard<std::mutex> shard_guard(shard.lock);
+      edges.swap(shard.edges);
+    }
+    delta->insert(delta->end(), edges.begin(), edges.end());
+  }
+
+  if (delta->empty() && (!compact || !old->delta_edges)) {
+    if (out_version) {
+      *out_version = old->Version();
+    }
+    return kGraphErrorSuccess;
+  }
+
+  // New batch is the smallest segment, merge it up while the one before it
+  // is not larger
+  next = new GraphSnapshot(old->Version() + 1, directed);
+  next->base = old->base;
+  next->deltas = old->deltas;
+  next->delta_edges = old->delta_edges + delta->size();
+  std::sort(delta->begin(), delta->end());
+  while (!next->deltas.empty() &&
+         next->deltas.back()->size() <= delta->size()) {
+    const GraphSnapshot::EdgeList &prev = *next->deltas.back();
+    std::shared_ptr<GraphSnapshot::EdgeList> merged =
+        std::make_shared<GraphSnapshot::EdgeList>(prev.size() + delta->size());
+    std::merge(prev.begin(), prev.end(), delta->begin(), delta->end(),
+               merged->begin());
+    delta = merged;
+    next->deltas.pop_back();
+  }
+  if (!delta->empty()) {
+    next->deltas.push_back(delta);
+  }
+
+  size_t limit =
+      std::max((size_t)kCompactMinEdges, old->base->E() / kCompactRatio);
+  if (compact || next->delta_edges > limit) {
+    std::shared_ptr<CsrGraph> base = std::make_shared<CsrGraph>();
+    GraphSnapshot::EdgeList all;
+    GraphError ret;
+
+    all.reserve(next->delta_edges);
+    for (auto &seg : next->deltas) {
+      all.insert(all.end(), seg->begin(), seg->end());
+    }
+    ret = base->Merge(*old->base, num_nodes, all);
+    if (ret != kGraphErrorSuccess) {
+      delete next;
+      return ret;
+    }
+    next->base = base;
+    next->deltas.clear();
+    next->delta_edges = 0;
+  }
+
+  current.store(next);
+  retired.push_back(Retired{old, ++global_epoch});
+  Reclaim();
+
+  if (out_version) {
+    *out_version = next->Version();
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Free retired snapshots no reader can reach anymore. Called with
+// publish_lock held.
+//**************************************************************************************************
+void ConcurrentGraph::Reclaim() {
+  uint64_t oldest = global_epoch.load();
+
+  for (int i = 0; i < kMaxReaders; i++) {
+    uint64_t e = slots[i].epoch.load();
+    if (e && e < oldest) {
+      oldest = e;
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < retired.size(); i++) {
+    if (retired[i].epoch <= oldest) {
+      delete retired[i].snap;
+    } else {
+      retired[kept++] = retired[i];
+    }
+  }
+  retired.resize(kept);
+}
@@ -0,0 +1,200 @@
+#include "csr_graph.h"
+#include <algorithm>
+
+// Vertices whose adjacency is sorted by a single task
+static const size_t kSortGrain = 256;
+
+//**************************************************************************************************
+// Copy adjacency of a graph
+//**************************************************************************************************
+GraphError CsrGraph::Build(Graph &g) {
+  Graph::VertexListIterator v_it(g);
+  std::vector<std::pair<int, int>> edges;
+
+  edges.reserve(g.E());
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      edges.push_back(
+          std::make_pair(v->getId(), e_it.getEdge()->getVertex()->getId()));
+    }
+  }
+  return Build(g.V(), edges);
+}
+
+//**************************************************************************************************
+// Symmetric copy of a graph without self loops and parallel edges
+//**************************************************************************************************
+GraphError CsrGraph::BuildUndirectedSimple(Graph &g, TaskScheduler *sched) {
+  Graph::VertexListIterator v_it(g);
+  std::vector<std::pair<int, int>> edges;
+  GraphError ret;
+
+  edges.reserve(g.E());
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      int u = e_it.getEdge()->getVertex()->getId();
+      if (u == v->getId()) {
+        continue;
+      }
+      edges.push_back(std::make_pair(v->getId(), u));
+      if (g.isDirected()) {
+        edges.push_back(std::make_pair(u, v->getId()));
+      }
+    }
+  }
+  ret = Build(g.V(), edges);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  SortAdjacency(true, sched);
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Build from edge pairs with a counting sort on the source
+//**************************************************************************************************
+GraphError CsrGraph::Build(int n,
+                           const std::vector<std::pair<int, int>> &edges) {
+  std::vector<size_t> fill;
+
+  if (n < 0) {
+    return kGraphErrorBadArgs;
+  }
+  for (auto &e : edges) {
+    if (e.first < 0 || e.first >= n || e.second < 0 || e.second >= n) {
+      return kGraphErrorBadArgs;
+    }
+  }
+
+  offsets.assign(n + 1, 0);
+  for (auto &e : edges) {
+    offsets[e.first + 1]++;
+  }
+  for (int v = 0; v < n; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+
+  targets.resize(edges.size());
+  fill.assign(offsets.begin(), offsets.end() - 1);
+  for (auto &e : edges) {
+    targets[fill[e.first]++] = e.second;
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Merge base with appended edges
+//**************************************************************************************************
+GraphError CsrGraph::Merge(const CsrGraph &base, int n,
+                           const std::vector<std::pair<int, int>> &delta) {
+  std::vector<size_t> fill;
+
+  n = std::max(n, base.V());
+  for (auto &e : delta) {
+    if (e.first < 0 || e.first >= n || e.second < 0 || e.second >= n) {
+      return kGraphErrorBadArgs;
+    }
+  }
+
+  offsets.assign(n + 1, 0);
+  for (int v = 0; v < base.V(); v++) {
+    offsets[v + 1] = base.Degree(v);
+  }
+  for (auto &e : delta) {
+    offsets[e.first + 1]++;
+  }
+  for (int v = 0; v < n; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+
+  targets.resize(offsets[n]);
+  fill.assign(offsets.begin(), offsets.end() - 1);
+  for (int v = 0; v < base.V(); v++) {
+    fill[v] = std::copy(base.NeighborsBegin(v), base.NeighborsEnd(v),
+                        targets.begin() + offsets[v]) -
+              targets.begin();
+  }
+  for (auto &e : delta) {
+    targets[fill[e.first]++] = e.second;
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Sort adjacency lists and drop repeated targets when asked to
+//**************************************************************************************************
+void CsrGraph::SortAdjacency(bool unique, TaskScheduler *sched) {
+  int n = V();
+  std::vector<size_t> sizes(n, 0);
+
+  auto sort_range = [&](size_t lo, size_t hi) {
+    for (size_t v = lo; v < hi; v++) {
+      int *first = &targets[0] + offsets[v];
+      int *last = &targets[0] + offsets[v + 1];
+      std::sort(first, last);
+      sizes[v] = unique ? std::unique(first, last) - first : last - first;
+    }
+  };
+
+  if (targets.empty()) {
+    return;
+  }
+  if (sched) {
+    sched->ParallelFor(0, n, kSortGrain, sort_range);
+  } else {
+    sort_range(0, n);
+  }
+
+  if (!unique) {
+    return;
+  }
+
+  // Compact the deduplicated lists towards the front
+  size_t out = 0;
+  for (int v = 0; v < n; v++) {
+    size_t start = offsets[v];
+    offsets[v] = out;
+    if (out != start) {
+      std::copy(targets.begin() + start, targets.begin() + start + sizes[v],
+                targets.begin() + out);
+    }
+    out += sizes[v];
+  }
+  offsets[n] = out;
+  targets.resize(out);
+}
+
+//**************************************************************************************************
+// Breadth first levels from a source vertex
+//**************************************************************************************************
+GraphError CsrGraph::BfsLevels(int source, std::vector<int> &out_level) const {
+  std::vector<int> frontier, next;
+  int curr_level = 0;
+
+  if (source < 0 || source >= V()) {
+    return kGraphErrorBadArgs;
+  }
+
+  out_level.assign(V(), -1);
+  out_level[source] = 0;
+  frontier.push_back(source);
+
+  while (!frontier.empty()) {
+    next.clear();
+    for (int v : frontier) {
+      for (const int *u = NeighborsBegin(v); u != NeighborsEnd(v); ++u) {
+        if (out_level[*u] < 0) {
+          out_level[*u] = curr_level + 1;
+          next.push_back(*u);
+        }
+      }
+    }
+    frontier.swap(next);
+    curr_level++;
+  }
+  return kGraphErrorSuccess;
+}
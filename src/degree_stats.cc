@@ -0,0 +1,112 @@
+#include "degree_stats.h"
+#include <algorithm>
+#include <atomic>
+
+//**************************************************************************************************
+// Histogram of degree(0) .. degree(n - 1)
+//**************************************************************************************************
+template <typename DegreeFn>
+void DegreeHistogram::Count(size_t n, const DegreeFn &degree,
+                            TaskScheduler &sched) {
+  size_t chunks = (n + kVertexGrain - 1) / kVertexGrain;
+  std::vector<int> chunk_max(chunks, 0);
+  int max_degree = 0;
+
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    int m = 0;
+    for (size_t v = lo; v < hi; v++) {
+      m = std::max(m, degree(v));
+    }
+    chunk_max[lo / kVertexGrain] = m;
+  });
+  for (int m : chunk_max) {
+    max_degree = std::max(max_degree, m);
+  }
+
+  std::vector<std::atomic<uint64_t>> shared(max_degree + 1);
+  for (auto &c : shared) {
+    c.store(0, std::memory_order_relaxed);
+  }
+
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    std::vector<uint64_t> local(std::min(max_degree + 1, (int)kLocalDegrees), 0);
+    for (size_t v = lo; v < hi; v++) {
+      int d = degree(v);
+      if (d < kLocalDegrees) {
+        local[d]++;
+      } else {
+        shared[d].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    for (size_t d = 0; d < local.size(); d++) {
+      if (local[d]) {
+        shared[d].fetch_add(local[d], std::memory_order_relaxed);
+      }
+    }
+  });
+
+  counts.resize(n ? max_degree + 1 : 0);
+  for (size_t d = 0; d < counts.size(); d++) {
+    counts[d] = shared[d].load(std::memory_order_relaxed);
+  }
+  num_vertices = n;
+}
+
+//**************************************************************************************************
+// Histogram of adjacency list lengths
+//**************************************************************************************************
+GraphError DegreeHistogram::Build(const CsrGraph &csr, TaskScheduler &sched) {
+  Count(csr.V(), [&csr](size_t v) { return csr.Degree(v); }, sched);
+  num_edges = csr.E();
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Histogram of out degrees of a graph, from the degrees the graph tracks
+//**************************************************************************************************
+GraphError DegreeHistogram::Build(Graph &g, TaskScheduler &sched) {
+  Graph::VertexListIterator v_it(g);
+  std::vector<int> degree(g.V(), 0);
+
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    if (v->getId() < 0 || v->getId() >= g.V()) {
+      return kGraphErrorBadArgs;
+    }
+    degree[v->getId()] = g.getDegree(v);
+  }
+  Count(degree.size(), [&degree](size_t v) { return degree[v]; }, sched);
+  num_edges = g.E();
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Smallest degree present
+//**************************************************************************************************
+int DegreeHistogram::MinDegree() {
+  for (size_t d = 0; d < counts.size(); d++) {
+    if (counts[d]) {
+      return d;
+    }
+  }
+  return 0;
+}
+
+//**************************************************************************************************
+// Degree percentile
+//**************************************************************************************************
+int DegreeHistogram::Percentile(double q) {
+  uint64_t seen = 0;
+
+  if (!num_vertices) {
+    return 0;
+  }
+  q = std::min(std::max(q, 0.0), 1.0);
+  for (size_t d = 0; d < counts.size(); d++) {
+    seen += counts[d];
+    if (counts[d] && seen >= q * num_vertices) {
+      return d;
+    }
+  }
+  return MaxDegree();
+}
@@ -32,7 +32,9 @@ GraphError Graph::InsertEdge(const Vertex *u, const Vertex *v, int weight) {
 
   const Vertex *v1;
   const Vertex *v2;
-  if (!v || !u || v->getId() >= num_nodes || u->getId() >= num_nodes) {
+  // ids index dense per vertex arrays, keep them in [0, num_nodes)
+  if (!v || !u || v->getId() < 0 || u->getId() < 0 ||
+      v->getId() >= num_nodes || u->getId() >= num_nodes) {
     return kGraphErrorBadArgs;
   }
 
@@ -55,15 +57,72 @@ GraphError Graph::InsertEdge(const Vertex *u, const Vertex *v, int weight) {
     delete v;
   }
 
-  adj_list[v1].push_back(new Edge(0, v2));
+  adj_list[v1].push_back(new Edge(weight, v2));
   num_edges++;
   vertex_degree[v1]++;
 
   if (!directed) {
-    adj_list[v2].push_back(new Edge(0, v1));
+    adj_list[v2].push_back(new Edge(weight, v1));
     num_edges++;
     vertex_degree[v2]++;
+  } else {
+    // Sinks still get an (empty) adjacency entry, edge iteration relies on it
+    adj_list[v2];
   }
 
   return kGraphErrorSuccess;
 }
+
+//**************************************************************************************************
+// Destructor, frees vertices and edges
+//**************************************************************************************************
+Graph::~Graph() {
+  for (auto &adj : adj_list) {
+    for (auto e : adj.second) {
+      delete e;
+    }
+  }
+  for (auto &v : vertex_list) {
+    delete v.second;
+  }
+  adj_list.clear();
+  vertex_list.clear();
+  vertex_degree.clear();
+}
+
+//**************************************************************************************************
+// Dense edge numbering
+//**************************************************************************************************
+void Graph::GetEdgeOffsets(std::vector<size_t> &out) {
+  out.assign(num_nodes + 1, 0);
+  for (auto &adj : adj_list) {
+    out[adj.first->getId() + 1] = adj.second.size();
+  }
+  for (int v = 0; v < num_nodes; v++) {
+    out[v + 1] += out[v];
+  }
+}
+
+//**************************************************************************************************
+// Memory held by the graph
+//**************************************************************************************************
+MemoryReport Graph::MemoryUsage() {
+  MemoryReport report("Graph");
+  size_t adj_vectors = 0;
+  size_t edges = 0;
+
+  for (auto &adj : adj_list) {
+    adj_vectors += MemoryReport::VectorBytes(adj.second);
+    edges += adj.second.size();
+  }
+
+  report.Add("object", sizeof(Graph));
+  report.Add("vertex_list", MemoryReport::UnorderedMapBytes(vertex_list));
+  report.Add("vertices",
+             vertex_list.size() * MemoryReport::HeapBytes(sizeof(Vertex)));
+  report.Add("vertex_degree", MemoryReport::UnorderedMapBytes(vertex_degree));
+  report.Add("adj_list", MemoryReport::UnorderedMapBytes(adj_list));
+  report.Add("adj_list vectors", adj_vectors);
+  report.Add("edges", edges * MemoryReport::HeapBytes(sizeof(Edge)));
+  return report;
+}
@@ -29,7 +29,8 @@ static int debug = 0;
 //**************************************************************************************************
 class GParser {
 public:
-  virtual GraphError GetGraphFromInput(std::vector<Graph *> &out_graphs) = 0;
+  virtual GraphError GetGraphFromInput(std::vector<Graph *> &out_graphs,
+                                       Profiler *prof) = 0;
 };
 
 //**************************************************************************************************
@@ -37,7 +38,9 @@ public:
 //**************************************************************************************************
 class UvaParser : public GParser {
 public:
-  GraphError GetGraphFromInput(std::vector<Graph *> &out_graphs) {
+  GraphError GetGraphFromInput(std::vector<Graph *> &out_graphs,
+                               Profiler *prof) {
+    std::vector<std::pair<int, int>> edges;
 
     if (!istr.good()) {
       ERROR("input stream not initialized\n");
@@ -54,27 +57,41 @@ public:
     }
 
     while (!istr.eof()) {
-      int num_nodes;
-      int num_edges;
-      int v1, v2;
+      int num_nodes = 0;
+      int num_edges = 0;
+      int v1 = 0, v2 = 0;
       GraphError ret;
 
-      istr >> num_nodes;
+      // Read the whole edge list first, so that reading and insertion can be
+      // profiled apart
+      {
+        Profiler::Scope scope(prof, "parse");
+
+        istr >> num_nodes;
+        if (num_nodes) {
+          istr >> num_edges;
+          edges.clear();
+          while (num_edges-- > 0) {
+            istr >> v1 >> v2;
+            edges.push_back(std::make_pair(v1, v2));
+          }
+        }
+      }
 
       if (!num_nodes) {
         break;
       }
 
+      Profiler::Scope scope(prof, "build");
       Graph *g = new Graph(num_nodes, directed);
 
-      istr >> num_edges;
-      while (num_edges--) {
-        istr >> v1 >> v2;
+      for (auto &e : edges) {
         // Assume weight as 0
-        LOG("Inserting edge %d %d\n", v1, v2);
-        ret = g->InsertEdge(v1, v2, 0);
+        LOG("Inserting edge %d %d\n", e.first, e.second);
+        ret = g->InsertEdge(e.first, e.second, 0);
         if (ret != kGraphErrorSuccess) {
-          ERROR("Unable to insert edge %d %d, ret = %d\n", v1, v2, ret);
+          ERROR("Unable to insert edge %d %d, ret = %d\n", e.first, e.second,
+                ret);
           return ret;
         }
       }
@@ -122,7 +139,8 @@ public:
 // Get Graph Instance from input file
 //**************************************************************************************************
 GraphError GraphParser::GetGraphsFromFile(const char *path,
-                                          std::vector<Graph *> &out_graphs) {
+                                          std::vector<Graph *> &out_graphs,
+                                          Profiler *prof) {
   GraphError ret;
   std::fstream fstr;
   GParser *gp;
@@ -140,7 +158,7 @@ GraphError GraphParser::GetGraphsFromFile(const char *path,
     return kGraphErrorUnhandled;
   }
 
-  ret = gp->GetGraphFromInput(out_graphs);
+  ret = gp->GetGraphFromInput(out_graphs, prof);
   if (ret != kGraphErrorSuccess) {
     ERROR("GetGraphFromInput(): ret = %d\n", ret);
     goto cleanup;
@@ -0,0 +1,131 @@
+#include "kcore.h"
+#include <algorithm>
+#include <atomic>
+
+//**************************************************************************************************
+// Construct k-core decomposition for a given graph instance
+//**************************************************************************************************
+KCore::KCore(Graph &G, TaskScheduler &s) : g(&G), sched(s), max_core(0) {}
+
+//**************************************************************************************************
+// Construct k-core decomposition for dense graphs only
+//**************************************************************************************************
+KCore::KCore(TaskScheduler &s) : g(nullptr), sched(s), max_core(0) {}
+
+//**************************************************************************************************
+// Core number of a vertex
+//**************************************************************************************************
+int KCore::GetCoreNumber(const Vertex *v) {
+  if (!v || v->getId() < 0 || v->getId() >= (int)core.size()) {
+    return -1;
+  }
+  return core[v->getId()];
+}
+
+//**************************************************************************************************
+// Decompose the graph given at construction
+//**************************************************************************************************
+GraphError KCore::PerformDecomposition() {
+  CsrGraph csr;
+  GraphError ret;
+
+  if (!g) {
+    return kGraphErrorBadArgs;
+  }
+  ret = csr.BuildUndirectedSimple(*g, &sched);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  return PerformDecomposition(csr);
+}
+
+//**************************************************************************************************
+// Peel vertices bucket by bucket
+//**************************************************************************************************
+GraphError KCore::PerformDecomposition(const CsrGraph &csr) {
+  std::vector<std::vector<int>> buckets;
+  std::vector<int> frontier;
+  int n = csr.V();
+  int max_degree = 0;
+  int peeled = 0;
+
+  std::unique_ptr<std::atomic<int>[]> degree(new std::atomic<int>[n]);
+  std::unique_ptr<std::atomic<int>[]> core_num(new std::atomic<int>[n]);
+  for (int v = 0; v < n; v++) {
+    degree[v].store(csr.Degree(v), std::memory_order_relaxed);
+    core_num[v].store(-1, std::memory_order_relaxed);
+    max_degree = std::max(max_degree, csr.Degree(v));
+  }
+  buckets.resize(max_degree + 1);
+  for (int v = 0; v < n; v++) {
+    buckets[csr.Degree(v)].push_back(v);
+  }
+
+  max_core = 0;
+  for (int k = 0; k <= max_degree && peeled < n; k++) {
+    // Buckets are lazy, skip vertices that were peeled or moved lower
+    frontier.clear();
+    for (int v : buckets[k]) {
+      if (core_num[v].load(std::memory_order_relaxed) < 0 &&
+          degree[v].load(std::memory_order_relaxed) <= k) {
+        core_num[v].store(k, std::memory_order_relaxed);
+        frontier.push_back(v);
+      }
+    }
+    std::vector<int>().swap(buckets[k]);
+
+    while (!frontier.empty()) {
+      size_t chunks = (frontier.size() + kFrontierGrain - 1) / kFrontierGrain;
+      std::vector<std::vector<int>> next(chunks);
+      std::vector<std::vector<std::pair<int, int>>> moved(chunks);
+
+      peeled += frontier.size();
+      max_core = k;
+
+      // A neighbour whose degree drops to k joins this core, one that stays
+      // above k is queued again in the bucket of its new degree
+      sched.ParallelFor(0, frontier.size(), kFrontierGrain,
+                        [&](size_t lo, size_t hi) {
+                          size_t c = lo / kFrontierGrain;
+                          for (size_t i = lo; i < hi; i++) {
+                            int v = frontier[i];
+                            for (const int *w = csr.NeighborsBegin(v);
+                                 w != csr.NeighborsEnd(v); ++w) {
+                              if (core_num[*w].load(
+                                      std::memory_order_relaxed) >= 0) {
+                                continue;
+                              }
+                              int old = degree[*w].fetch_sub(
+                                  1, std::memory_order_relaxed);
+                              if (old == k + 1) {
+                                next[c].push_back(*w);
+                              } else if (old > k + 1) {
+                                moved[c].push_back(std::make_pair(old - 1, *w));
+                              }
+                            }
+                          }
+                        });
+
+      frontier.clear();
+      for (auto &part : next) {
+        for (int w : part) {
+          if (core_num[w].load(std::memory_order_relaxed) < 0) {
+            core_num[w].store(k, std::memory_order_relaxed);
+            frontier.push_back(w);
+          }
+        }
+      }
+      for (auto &part : moved) {
+        for (auto &m : part) {
+          buckets[m.first].push_back(m.second);
+        }
+      }
+    }
+  }
+
+  core.resize(n);
+  for (int v = 0; v < n; v++) {
+    core[v] = core_num[v].load(std::memory_order_relaxed);
+  }
+  return kGraphErrorSuccess;
+}
@@ -0,0 +1,427 @@
+#include "landmark_index.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+//**************************************************************************************************
+// Macros
+//**************************************************************************************************
+// Identifies an index file and its layout version
+#define LANDMARK_INDEX_MAGIC "ADMPLL02"
+#define LANDMARK_INDEX_MAGIC_LEN 8
+
+//**************************************************************************************************
+// Types
+//**************************************************************************************************
+// Distance marking a hub the root has no label entry for
+static const int kInfDist = INT_MAX / 2;
+
+// Per BFS scratch space, reused across roots
+struct PllScratch {
+  // distance from the root to each hub rank of its label
+  std::vector<int> root_dist;
+  // BFS distance per vertex, -1 if not visited
+  std::vector<int> visit_dist;
+};
+
+//**************************************************************************************************
+// Pruned BFS from a single root. Entries for reached vertices are collected
+// in out instead of being written to the labels, so that roots of a batch can
+// run concurrently.
+//**************************************************************************************************
+void LandmarkIndex::PrunedBfs(const CsrGraph &csr, int root,
+                              const std::vector<RootLabels> &root_side,
+                              const std::vector<RootLabels> &reach_side,
+                              std::vector<int> &root_dist,
+                              std::vector<int> &visit_dist, RootLabels &out) {
+  std::vector<int> queue;
+
+  for (auto &l : root_side[root]) {
+    root_dist[l.first] = l.second;
+  }
+
+  visit_dist[root] = 0;
+  queue.push_back(root);
+
+  for (size_t idx = 0; idx < queue.size(); idx++) {
+    int u = queue[idx];
+    int d = visit_dist[u];
+    bool pruned = false;
+
+    // Already answered through a higher ranked hub
+    for (auto &l : reach_side[u]) {
+      if (root_dist[l.first] + l.second <= d) {
+        pruned = true;
+        break;
+      }
+    }
+    if (pruned) {
+      continue;
+    }
+
+    out.push_back(std::make_pair(u, d));
+    for (const int *w = csr.NeighborsBegin(u); w != csr.NeighborsEnd(u);
+         ++w) {
+      if (visit_dist[*w] < 0) {
+        visit_dist[*w] = d + 1;
+        queue.push_back(*w);
+      }
+    }
+  }
+
+  for (int u : queue) {
+    visit_dist[u] = -1;
+  }
+  for (auto &l : root_side[root]) {
+    root_dist[l.first] = kInfDist;
+  }
+}
+
+//**************************************************************************************************
+// Copy per vertex labels into flat arrays
+//**************************************************************************************************
+void LandmarkIndex::Flatten(const std::vector<RootLabels> &labels,
+                            Labels &out) {
+  out.offsets.assign(labels.size() + 1, 0);
+  for (size_t v = 0; v < labels.size(); v++) {
+    out.offsets[v + 1] = out.offsets[v] + labels[v].size();
+  }
+
+  out.hubs.resize(out.offsets.back());
+  out.dists.resize(out.offsets.back());
+  for (size_t v = 0; v < labels.size(); v++) {
+    uint64_t pos = out.offsets[v];
+    for (auto &l : labels[v]) {
+      out.hubs[pos] = l.first;
+      out.dists[pos] = l.second;
+      pos++;
+    }
+  }
+}
+
+//**************************************************************************************************
+// Sum of a mixed hash of every (source, target) pair, independent of the
+// order vertices and edges are stored in
+//**************************************************************************************************
+uint64_t LandmarkIndex::EdgeChecksum(Graph &g) {
+  Graph::VertexListIterator v_it(g);
+  uint64_t sum = 0;
+
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      uint64_t x = ((uint64_t)(uint32_t)v->getId() << 32) |
+                   (uint32_t)e_it.getEdge()->getVertex()->getId();
+      // splitmix64 finalizer
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      sum += x ^ (x >> 31);
+    }
+  }
+  return sum;
+}
+
+//**************************************************************************************************
+// Index built from g
+//**************************************************************************************************
+bool LandmarkIndex::Matches(Graph &g) {
+  return num_nodes == g.V() && directed == g.isDirected() &&
+         num_edges == (uint64_t)g.E() && checksum == EdgeChecksum(g);
+}
+
+//**************************************************************************************************
+// Build the index
+//**************************************************************************************************
+GraphError LandmarkIndex::Build(Graph &g, TaskScheduler &sched) {
+  CsrGraph fwd, bwd;
+  std::vector<std::pair<int, int>> edges;
+  std::vector<int> order, degree;
+  std::vector<RootLabels> out_l, in_l;
+  std::vector<std::unique_ptr<PllScratch>> scratch_pool;
+  std::mutex pool_lock;
+  GraphError ret;
+  int n = g.V();
+
+  ret = fwd.Build(g);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  fwd.SortAdjacency(true, &sched);
+
+  num_nodes = n;
+  directed = g.isDirected();
+  num_edges = g.E();
+  checksum = EdgeChecksum(g);
+
+  // Reverse graph for labels of paths leaving a vertex
+  if (directed) {
+    for (int v = 0; v < n; v++) {
+      for (const int *u = fwd.NeighborsBegin(v); u != fwd.NeighborsEnd(v);
+           ++u) {
+        edges.push_back(std::make_pair(*u, v));
+      }
+    }
+    ret = bwd.Build(n, edges);
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+    std::vector<std::pair<int, int>>().swap(edges);
+  }
+
+  // Roots in decreasing degree, ties broken by id
+  degree.assign(n, 0);
+  for (int v = 0; v < n; v++) {
+    degree[v] += fwd.Degree(v);
+    if (directed) {
+      degree[v] += bwd.Degree(v);
+    }
+  }
+  order.resize(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&degree](int a, int b) { return degree[a] > degree[b]; });
+
+  out_l.resize(n);
+  if (directed) {
+    in_l.resize(n);
+  }
+  // Undirected graphs have a single label set
+  std::vector<RootLabels> &reach_l = directed ? in_l : out_l;
+
+  for (int b = 0; b < n;) {
+    int e = std::min(n, b < kSequentialRoots ? b + 1 : b + kRootBatch);
+    std::vector<RootLabels> fwd_found(e - b), bwd_found(e - b);
+
+    sched.ParallelFor(b, e, 1, [&](size_t lo, size_t hi) {
+      std::unique_ptr<PllScratch> s;
+      {
+        std::lock_guard<std::mutex> guard(pool_lock);
+        if (!scratch_pool.empty()) {
+          s = std::move(scratch_pool.back());
+          scratch_pool.pop_back();
+        }
+      }
+      if (!s) {
+        s.reset(new PllScratch());
+        s->root_dist.assign(n, kInfDist);
+        s->visit_dist.assign(n, -1);
+      }
+
+      for (size_t r = lo; r < hi; r++) {
+        // root to vertex: paths leave the root and enter the vertex
+        PrunedBfs(fwd, order[r], out_l, reach_l, s->root_dist,
+                  s->visit_dist, fwd_found[r - b]);
+        if (directed) {
+          PrunedBfs(bwd, order[r], in_l, out_l, s->root_dist,
+                    s->visit_dist, bwd_found[r - b]);
+        }
+      }
+
+      std::lock_guard<std::mutex> guard(pool_lock);
+      scratch_pool.push_back(std::move(s));
+    });
+
+    // Append in rank order so every label stays sorted by hub
+    for (int r = b; r < e; r++) {
+      for (auto &f : fwd_found[r - b]) {
+        reach_l[f.first].push_back(std::make_pair(r, f.second));
+      }
+      for (auto &f : bwd_found[r - b]) {
+        out_l[f.first].push_back(std::make_pair(r, f.second));
+      }
+    }
+    b = e;
+  }
+
+  Flatten(out_l, out_labels);
+  if (directed) {
+    Flatten(in_l, in_labels);
+  } else {
+    in_labels = Labels();
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Merge out label of from with in label of to
+//**************************************************************************************************
+int LandmarkIndex::Query(const Labels &out_side, const Labels &in_side,
+                         int from, int to) {
+  uint64_t i = out_side.offsets[from], i_end = out_side.offsets[from + 1];
+  uint64_t j = in_side.offsets[to], j_end = in_side.offsets[to + 1];
+  int best = kInfDist;
+
+  while (i < i_end && j < j_end) {
+    int hi = out_side.hubs[i], hj = in_side.hubs[j];
+    if (hi < hj) {
+      i++;
+    } else if (hj < hi) {
+      j++;
+    } else {
+      best = std::min(best, out_side.dists[i] + in_side.dists[j]);
+      i++;
+      j++;
+    }
+  }
+  return best;
+}
+
+//**************************************************************************************************
+// Distance query by vertex id
+//**************************************************************************************************
+GraphError LandmarkIndex::GetDistance(int from, int to, int *out) {
+  int d;
+
+  if (!out || from < 0 || from >= num_nodes || to < 0 || to >= num_nodes) {
+    return kGraphErrorBadArgs;
+  }
+
+  d = Query(out_labels, directed ? in_labels : out_labels, from, to);
+  if (d >= kInfDist) {
+    return kGraphErrorNoPath;
+  }
+  *out = d;
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Distance query by vertex
+//**************************************************************************************************
+GraphError LandmarkIndex::GetDistance(const Vertex *from, const Vertex *to,
+                                      int *out) {
+  if (!from || !to) {
+    return kGraphErrorBadArgs;
+  }
+  return GetDistance(from->getId(), to->getId(), out);
+}
+
+//**************************************************************************************************
+// Serialize one label set
+//**************************************************************************************************
+GraphError LandmarkIndex::WriteLabels(std::ostream &os, const Labels &l) {
+  uint64_t entries = l.hubs.size();
+
+  os.write(reinterpret_cast<const char *>(&entries), sizeof(entries));
+  os.write(reinterpret_cast<const char *>(l.offsets.data()),
+           l.offsets.size() * sizeof(uint64_t));
+  os.write(reinterpret_cast<const char *>(l.hubs.data()),
+           entries * sizeof(int));
+  os.write(reinterpret_cast<const char *>(l.dists.data()),
+           entries * sizeof(int));
+  return os.good() ? kGraphErrorSuccess : kGraphErrorUnhandled;
+}
+
+//**************************************************************************************************
+// Deserialize one label set over n vertices
+//**************************************************************************************************
+GraphError LandmarkIndex::ReadLabels(std::istream &is, int n, Labels &l) {
+  uint64_t entries = 0;
+
+  is.read(reinterpret_cast<char *>(&entries), sizeof(entries));
+  if (!is.good()) {
+    return kGraphErrorUnhandled;
+  }
+
+  l.offsets.resize(n + 1);
+  is.read(reinterpret_cast<char *>(l.offsets.data()),
+          l.offsets.size() * sizeof(uint64_t));
+  if (!is.good() || l.offsets[0] != 0 || l.offsets[n] != entries) {
+    return kGraphErrorUnhandled;
+  }
+  for (int v = 0; v < n; v++) {
+    if (l.offsets[v] > l.offsets[v + 1]) {
+      return kGraphErrorUnhandled;
+    }
+  }
+
+  l.hubs.resize(entries);
+  l.dists.resize(entries);
+  is.read(reinterpret_cast<char *>(l.hubs.data()), entries * sizeof(int));
+  is.read(reinterpret_cast<char *>(l.dists.data()), entries * sizeof(int));
+  return is.good() ? kGraphErrorSuccess : kGraphErrorUnhandled;
+}
+
+//**************************************************************************************************
+// Write index to file
+//**************************************************************************************************
+GraphError LandmarkIndex::Save(const char *path) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  int32_t header[2] = {num_nodes, directed};
+  uint64_t source[2] = {num_edges, checksum};
+  GraphError ret;
+
+  if (!path || !os.is_open()) {
+    return kGraphErrorBadArgs;
+  }
+
+  os.write(LANDMARK_INDEX_MAGIC, LANDMARK_INDEX_MAGIC_LEN);
+  os.write(reinterpret_cast<const char *>(header), sizeof(header));
+  os.write(reinterpret_cast<const char *>(source), sizeof(source));
+  ret = WriteLabels(os, out_labels);
+  if (ret == kGraphErrorSuccess && directed) {
+    ret = WriteLabels(os, in_labels);
+  }
+  return ret;
+}
+
+//**************************************************************************************************
+// Read index from file
+//**************************************************************************************************
+GraphError LandmarkIndex::Load(const char *path) {
+  std::ifstream is(path, std::ios::binary);
+  char magic[LANDMARK_INDEX_MAGIC_LEN];
+  int32_t header[2];
+  uint64_t source[2];
+  GraphError ret;
+
+  if (!path || !is.is_open()) {
+    return kGraphErrorBadArgs;
+  }
+
+  is.read(magic, sizeof(magic));
+  is.read(reinterpret_cast<char *>(header), sizeof(header));
+  is.read(reinterpret_cast<char *>(source), sizeof(source));
+  if (!is.good() ||
+      memcmp(magic, LANDMARK_INDEX_MAGIC, LANDMARK_INDEX_MAGIC_LEN) ||
+      header[0] < 0) {
+    return kGraphErrorUnhandled;
+  }
+
+  num_nodes = header[0];
+  directed = header[1];
+  num_edges = source[0];
+  checksum = source[1];
+  ret = ReadLabels(is, num_nodes, out_labels);
+  if (ret == kGraphErrorSuccess && directed) {
+    ret = ReadLabels(is, num_nodes, in_labels);
+  }
+  if (ret != kGraphErrorSuccess) {
+    num_nodes = 0;
+    num_edges = 0;
+    checksum = 0;
+    out_labels = Labels();
+    in_labels = Labels();
+  }
+  return ret;
+}
+
+//**************************************************************************************************
+// Read index from file, rejecting an index of another graph
+//**************************************************************************************************
+GraphError LandmarkIndex::Load(const char *path, Graph &g) {
+  GraphError ret;
+
+  ret = Load(path);
+  if (ret == kGraphErrorSuccess && !Matches(g)) {
+    num_nodes = 0;
+    num_edges = 0;
+    checksum = 0;
+    out_labels = Labels();
+    in_labels = Labels();
+    ret = kGraphErrorUnhandled;
+  }
+  return ret;
+}
@@ -0,0 +1,81 @@
+#include "message_transport.h"
+
+//**************************************************************************************************
+// Construct transport with n endpoints
+//**************************************************************************************************
+InProcessTransport::InProcessTransport(int n)
+    : arrived(0), generation(0), partial_sum(0), result(0) {
+  for (int i = 0; i < n; i++) {
+    mailboxes.emplace_back(new Mailbox());
+  }
+}
+
+//**************************************************************************************************
+// Append batch to the mailbox of the destination
+//**************************************************************************************************
+GraphError InProcessTransport::Send(int from, int to, int tag,
+                                    const std::vector<int> &batch) {
+  if (from < 0 || from >= NumEndpoints() || to < 0 || to >= NumEndpoints()) {
+    return kGraphErrorBadArgs;
+  }
+
+  Mailbox &mb = *mailboxes[to];
+  std::lock_guard<std::mutex> guard(mb.lock);
+  std::vector<int> &dst = mb.batches[tag];
+  dst.insert(dst.end(), batch.begin(), batch.end());
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Drain the mailbox of an endpoint for a tag
+//**************************************************************************************************
+GraphError InProcessTransport::Receive(int to, int tag, std::vector<int> &out) {
+  if (to < 0 || to >= NumEndpoints()) {
+    return kGraphErrorBadArgs;
+  }
+
+  Mailbox &mb = *mailboxes[to];
+  std::lock_guard<std::mutex> guard(mb.lock);
+  auto it = mb.batches.find(tag);
+  if (it != mb.batches.end()) {
+    out.insert(out.end(), it->second.begin(), it->second.end());
+    mb.batches.erase(it);
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Barrier over all endpoints
+//**************************************************************************************************
+GraphError InProcessTransport::Barrier(int endpoint) {
+  int64_t unused;
+  return AllReduceSum(endpoint, 0, &unused);
+}
+
+//**************************************************************************************************
+// Sum values of all endpoints. The last endpoint to arrive publishes the
+// result and releases the others.
+//**************************************************************************************************
+GraphError InProcessTransport::AllReduceSum(int endpoint, int64_t value,
+                                            int64_t *out) {
+  if (!out || endpoint < 0 || endpoint >= NumEndpoints()) {
+    return kGraphErrorBadArgs;
+  }
+
+  std::unique_lock<std::mutex> guard(collective_lock);
+  uint64_t my_generation = generation;
+
+  partial_sum += value;
+  if (++arrived == NumEndpoints()) {
+    result = partial_sum;
+    partial_sum = 0;
+    arrived = 0;
+    generation++;
+    collective_done.notify_all();
+  } else {
+    collective_done.wait(guard,
+                         [&] { return generation != my_generation; });
+  }
+  *out = result;
+  return kGraphErrorSuccess;
+}
@@ -0,0 +1,277 @@
+#include "pagerank.h"
+#include "spmv.h"
+#include <chrono>
+#include <cmath>
+
+//**************************************************************************************************
+// Sum of per chunk partial results, in chunk order so runs are reproducible
+//**************************************************************************************************
+static double SumPartials(const std::vector<double> &partials) {
+  double sum = 0;
+  for (double p : partials) {
+    sum += p;
+  }
+  return sum;
+}
+
+//**************************************************************************************************
+// Construct PageRank engine for a given graph instance
+//**************************************************************************************************
+PageRank::PageRank(Graph &G, TaskScheduler &s)
+    : g(G), sched(s), prepared(false), prepared_edges(0) {}
+
+//**************************************************************************************************
+// Rank of a vertex
+//**************************************************************************************************
+double PageRank::GetRank(const Vertex *v) {
+  if (!v || v->getId() < 0 || v->getId() >= (int)rank.size()) {
+    return 0;
+  }
+  return rank[v->getId()];
+}
+
+//**************************************************************************************************
+// Ranks to warm start from
+//**************************************************************************************************
+GraphError PageRank::SetInitialRanks(const std::vector<double> &ranks) {
+  if (ranks.size() != (size_t)g.V()) {
+    return kGraphErrorBadArgs;
+  }
+  rank = ranks;
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Build out and in adjacency, again whenever the graph gained or lost edges
+//**************************************************************************************************
+GraphError PageRank::Prepare() {
+  std::vector<std::pair<int, int>> edges;
+  GraphError ret;
+  int n = g.V();
+
+  if (prepared && prepared_edges == g.E()) {
+    return kGraphErrorSuccess;
+  }
+  prepared = false;
+
+  ret = out_edges.Build(g);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+
+  edges.reserve(out_edges.E());
+  for (int u = 0; u < n; u++) {
+    for (const int *v = out_edges.NeighborsBegin(u);
+         v != out_edges.NeighborsEnd(u); ++v) {
+      edges.push_back(std::make_pair(*v, u));
+    }
+  }
+  ret = in_edges.Build(n, edges);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  // Sorted sources keep the gathers of a vertex close together in memory
+  in_edges.SortAdjacency(false, &sched);
+
+  inv_degree.assign(n, 0);
+  for (int u = 0; u < n; u++) {
+    if (out_edges.Degree(u)) {
+      inv_degree[u] = 1.0 / out_edges.Degree(u);
+    }
+  }
+  next.assign(n, 0);
+  contrib.assign(n, 0);
+  acc.reset(new std::atomic<double>[n]);
+  prepared = true;
+  prepared_edges = g.E();
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// One power iteration, every vertex gathers from its in neighbours
+//**************************************************************************************************
+double PageRank::PullIteration(double damping) {
+  size_t n = rank.size();
+  size_t chunks = (n + kVertexGrain - 1) / kVertexGrain;
+  std::vector<double> dangling(chunks, 0), residual(chunks, 0);
+
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double d = 0;
+    for (size_t u = lo; u < hi; u++) {
+      contrib[u] = rank[u] * inv_degree[u];
+      d += inv_degree[u] ? 0 : rank[u];
+    }
+    dangling[lo / kVertexGrain] = d;
+  });
+
+  Spmv::Pull(in_edges, contrib.data(), next.data(), sched);
+
+  double base = (1 - damping + damping * SumPartials(dangling)) / n;
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double r = 0;
+    for (size_t v = lo; v < hi; v++) {
+      next[v] = base + damping * next[v];
+      r += std::fabs(next[v] - rank[v]);
+    }
+    residual[lo / kVertexGrain] = r;
+  });
+
+  rank.swap(next);
+  return SumPartials(residual);
+}
+
+//**************************************************************************************************
+// One power iteration, every vertex scatters to its out neighbours
+//**************************************************************************************************
+double PageRank::PushIteration(double damping) {
+  size_t n = rank.size();
+  size_t chunks = (n + kVertexGrain - 1) / kVertexGrain;
+  std::vector<double> dangling(chunks, 0), residual(chunks, 0);
+
+  for (size_t v = 0; v < n; v++) {
+    acc[v].store(0, std::memory_order_relaxed);
+  }
+
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double d = 0;
+    for (size_t u = lo; u < hi; u++) {
+      contrib[u] = rank[u] * inv_degree[u];
+      d += inv_degree[u] ? 0 : rank[u];
+    }
+    dangling[lo / kVertexGrain] = d;
+  });
+
+  Spmv::Push(out_edges, contrib.data(), acc.get(), sched);
+
+  double base = (1 - damping + damping * SumPartials(dangling)) / n;
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double r = 0;
+    for (size_t v = lo; v < hi; v++) {
+      next[v] = base + damping * acc[v].load(std::memory_order_relaxed);
+      r += std::fabs(next[v] - rank[v]);
+    }
+    residual[lo / kVertexGrain] = r;
+  });
+
+  rank.swap(next);
+  return SumPartials(residual);
+}
+
+//**************************************************************************************************
+// Push pending rank changes above threshold. Changes below it are carried
+// over to later iterations rather than dropped.
+//**************************************************************************************************
+double PageRank::DeltaIteration(double damping, double threshold,
+                                size_t *active) {
+  size_t n = rank.size();
+  size_t chunks = (n + kVertexGrain - 1) / kVertexGrain;
+  std::vector<double> dangling(chunks, 0), residual(chunks, 0);
+  std::vector<size_t> pushed(chunks, 0);
+
+  for (size_t v = 0; v < n; v++) {
+    acc[v].store(0, std::memory_order_relaxed);
+  }
+
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double d = 0;
+    size_t p = 0;
+    for (size_t u = lo; u < hi; u++) {
+      if (std::fabs(delta[u]) <= threshold) {
+        continue;
+      }
+      p++;
+      if (!inv_degree[u]) {
+        d += delta[u];
+      } else {
+        double c = delta[u] * inv_degree[u];
+        for (const int *v = out_edges.NeighborsBegin(u);
+             v != out_edges.NeighborsEnd(u); ++v) {
+          Spmv::AtomicAdd(acc[*v], c);
+        }
+      }
+      delta[u] = 0;
+    }
+    dangling[lo / kVertexGrain] = d;
+    pushed[lo / kVertexGrain] = p;
+  });
+
+  double spread = damping * SumPartials(dangling) / n;
+  sched.ParallelFor(0, n, kVertexGrain, [&](size_t lo, size_t hi) {
+    double r = 0;
+    for (size_t v = lo; v < hi; v++) {
+      double change =
+          spread + damping * acc[v].load(std::memory_order_relaxed);
+      rank[v] += change;
+      delta[v] += change;
+      r += std::fabs(change);
+    }
+    residual[lo / kVertexGrain] = r;
+  });
+
+  *active = 0;
+  for (size_t p : pushed) {
+    *active += p;
+  }
+  return SumPartials(residual);
+}
+
+//**************************************************************************************************
+// Iterate until converged or out of iterations
+//**************************************************************************************************
+GraphError PageRank::Run(const Options &opt) {
+  GraphError ret;
+  size_t n = g.V();
+
+  if (opt.damping < 0 || opt.damping >= 1 || opt.tolerance <= 0 ||
+      opt.max_iterations <= 0 ||
+      (opt.mode != kModePull && opt.mode != kModePush &&
+       opt.mode != kModeDelta)) {
+    return kGraphErrorBadArgs;
+  }
+
+  ret = Prepare();
+  if (ret != kGraphErrorSuccess || !n) {
+    return ret;
+  }
+
+  stats.clear();
+  bool warm = opt.warm_start && rank.size() == n;
+  if (opt.mode == kModeDelta && !warm) {
+    rank.assign(n, (1 - opt.damping) / n);
+    delta = rank;
+  } else if (!warm) {
+    rank.assign(n, 1.0 / n);
+  }
+
+  for (int it = 0; it < opt.max_iterations; it++) {
+    auto start = std::chrono::steady_clock::now();
+    IterationStats s;
+
+    s.iteration = it;
+    s.active = n;
+    if (opt.mode == kModeDelta && warm && it == 0) {
+      // One full iteration over the current graph, what it changed is the
+      // pending delta. Small graph changes only disturb a few vertices much.
+      s.residual = PullIteration(opt.damping);
+      delta.resize(n);
+      for (size_t v = 0; v < n; v++) {
+        delta[v] = rank[v] - next[v];
+      }
+    } else if (opt.mode == kModePull) {
+      s.residual = PullIteration(opt.damping);
+    } else if (opt.mode == kModePush) {
+      s.residual = PushIteration(opt.damping);
+    } else {
+      s.residual = DeltaIteration(opt.damping, opt.tolerance / n, &s.active);
+    }
+    s.seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    stats.push_back(s);
+
+    if (s.residual < opt.tolerance) {
+      break;
+    }
+  }
+  return kGraphErrorSuccess;
+}
@@ -0,0 +1,88 @@
+#include "parallel_bfs.h"
+
+//**************************************************************************************************
+// Construct parallel BFS for a given graph instance and scheduler
+//**************************************************************************************************
+ParallelBfs::ParallelBfs(Graph &G, TaskScheduler &s)
+    : level(G.V()), g(G), sched(s) {
+  for (auto &l : level) {
+    l.store(-1, std::memory_order_relaxed);
+  }
+}
+
+//**************************************************************************************************
+// Level of vertex in its search tree
+//**************************************************************************************************
+int ParallelBfs::GetLevel(const Vertex *v) {
+  if (!v || v->getId() < 0 || v->getId() >= (int)level.size()) {
+    return -1;
+  }
+  return level[v->getId()].load(std::memory_order_relaxed);
+}
+
+//**************************************************************************************************
+// Search every connected component
+//**************************************************************************************************
+GraphError ParallelBfs::PerformSearch() {
+  Graph::VertexListIterator v_it(g);
+  GraphError err = kGraphErrorSuccess;
+
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *curr_vertex = v_it.getVertex();
+    if (GetLevel(curr_vertex) < 0) {
+      err = PerformSearch(curr_vertex);
+      if (err != kGraphErrorSuccess) {
+        break;
+      }
+    }
+  }
+  return err;
+}
+
+//**************************************************************************************************
+// Search from starting vertex one level at a time
+//**************************************************************************************************
+GraphError ParallelBfs::PerformSearch(const Vertex *start_vertex) {
+  std::vector<const Vertex *> frontier;
+  std::vector<std::vector<const Vertex *>> next_parts;
+  int curr_level = 0;
+
+  if (!start_vertex || !g.validVertex(start_vertex) ||
+      start_vertex->getId() < 0 || start_vertex->getId() >= (int)level.size()) {
+    return kGraphErrorBadArgs;
+  }
+
+  level[start_vertex->getId()].store(0, std::memory_order_relaxed);
+  frontier.push_back(start_vertex);
+
+  while (!frontier.empty()) {
+    size_t num_parts = (frontier.size() + kFrontierGrain - 1) / kFrontierGrain;
+
+    next_parts.assign(num_parts, std::vector<const Vertex *>());
+
+    // Every chunk claims undiscovered neighbours with a CAS on their level
+    // and collects the winners into its own slot of next_parts
+    auto expand = [&](size_t lo, size_t hi) {
+      std::vector<const Vertex *> &out = next_parts[lo / kFrontierGrain];
+      for (size_t i = lo; i < hi; i++) {
+        Graph::EdgeListIterator e_it(g, frontier[i]);
+        for (e_it.begin(); !e_it.end(); ++e_it) {
+          const Vertex *neighbor = e_it.getEdge()->getVertex();
+          int expected = -1;
+          if (level[neighbor->getId()].compare_exchange_strong(
+                  expected, curr_level + 1, std::memory_order_relaxed)) {
+            out.push_back(neighbor);
+          }
+        }
+      }
+    };
+    sched.ParallelFor(0, frontier.size(), kFrontierGrain, expand);
+
+    frontier.clear();
+    for (auto &part : next_parts) {
+      frontier.insert(frontier.end(), part.begin(), part.end());
+    }
+    curr_level++;
+  }
+  return kGraphErrorSuccess;
+}
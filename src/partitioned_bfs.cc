@@ -0,0 +1,161 @@
+#include "partitioned_bfs.h"
+#include <thread>
+
+//**************************************************************************************************
+// Construct partitioned BFS
+//**************************************************************************************************
+PartitionedBfs::PartitionedBfs(PartitionedGraph &G, MessageTransport &t)
+    : pg(G), transport(t) {}
+
+//**************************************************************************************************
+// Level of a vertex
+//**************************************************************************************************
+int PartitionedBfs::GetLevel(int v) {
+  if (v < 0 || v >= (int)level.size()) {
+    return -1;
+  }
+  return level[v];
+}
+
+//**************************************************************************************************
+// Search from source, one thread per partition
+//**************************************************************************************************
+GraphError PartitionedBfs::PerformSearch(int source) {
+  std::vector<std::thread> threads;
+  std::vector<GraphError> results(pg.NumPartitions(), kGraphErrorSuccess);
+
+  if (source < 0 || source >= pg.V() ||
+      transport.NumEndpoints() != pg.NumPartitions()) {
+    return kGraphErrorBadArgs;
+  }
+
+  level.assign(pg.V(), -1);
+  stats.clear();
+
+  for (int p = 0; p < pg.NumPartitions(); p++) {
+    threads.emplace_back(
+        [this, p, source, &results] { results[p] = RunPartition(p, source); });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (auto ret : results) {
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+  }
+  return kGraphErrorSuccess;
+}
+
+//**************************************************************************************************
+// Send outgoing batches under tag, then collect the batches sent to p. Batches
+// for p itself bypass the transport.
+//**************************************************************************************************
+GraphError PartitionedBfs::Exchange(int p, int tag,
+                                    std::vector<std::vector<int>> &out,
+                                    std::vector<int> &in, int64_t &messages,
+                                    int64_t &bytes) {
+  GraphError ret;
+
+  in.clear();
+  for (int dst = 0; dst < (int)out.size(); dst++) {
+    if (out[dst].empty()) {
+      continue;
+    }
+    if (dst == p) {
+      in.insert(in.end(), out[dst].begin(), out[dst].end());
+    } else {
+      ret = transport.Send(p, dst, tag, out[dst]);
+      if (ret != kGraphErrorSuccess) {
+        return ret;
+      }
+      messages++;
+      bytes += out[dst].size() * sizeof(int);
+    }
+    out[dst].clear();
+  }
+
+  ret = transport.Barrier(p);
+  if (ret != kGraphErrorSuccess) {
+    return ret;
+  }
+  return transport.Receive(p, tag, in);
+}
+
+//**************************************************************************************************
+// Body of one partition. Every partition runs the same number of levels,
+// the frontier size is agreed on with an all reduce at the end of each one.
+//**************************************************************************************************
+GraphError PartitionedBfs::RunPartition(int p, int source) {
+  GraphPartition &part = pg.GetPartition(p);
+  std::vector<std::vector<int>> out(pg.NumPartitions());
+  std::vector<int> frontier, in;
+  int64_t global_frontier = 1;
+  int curr_level = 0;
+  GraphError ret;
+
+  if (pg.Owner(source) == p) {
+    level[source] = 0;
+    frontier.push_back(source);
+  }
+
+  while (global_frontier > 0) {
+    int64_t messages = 0, bytes = 0;
+    LevelStats level_stats;
+
+    // Expand: frontier vertices go down their grid column
+    for (int u : frontier) {
+      int col = pg.Owner(u) / pg.Rows();
+      for (int row = 0; row < pg.Rows(); row++) {
+        out[pg.At(row, col)].push_back(u);
+      }
+    }
+    ret = Exchange(p, 2 * curr_level, out, in, messages, bytes);
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+
+    // Traverse local edges, discovered vertices go along the grid row
+    for (int u : in) {
+      uint64_t first = part.offsets[u - part.source_first];
+      uint64_t last = part.offsets[u - part.source_first + 1];
+      for (uint64_t e = first; e < last; e++) {
+        out[pg.Owner(part.targets[e])].push_back(part.targets[e]);
+      }
+    }
+    ret = Exchange(p, 2 * curr_level + 1, out, in, messages, bytes);
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+
+    // Claim owned vertices reached for the first time
+    frontier.clear();
+    for (int v : in) {
+      if (level[v] < 0) {
+        level[v] = curr_level + 1;
+        frontier.push_back(v);
+      }
+    }
+
+    level_stats.level = curr_level;
+    level_stats.frontier = global_frontier;
+    ret = transport.AllReduceSum(p, messages, &level_stats.messages);
+    if (ret == kGraphErrorSuccess) {
+      ret = transport.AllReduceSum(p, bytes, &level_stats.bytes);
+    }
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+    if (p == 0) {
+      stats.push_back(level_stats);
+    }
+
+    ret = transport.AllReduceSum(p, frontier.size(), &global_frontier);
+    if (ret != kGraphErrorSuccess) {
+      return ret;
+    }
+    curr_level++;
+  }
+  return kGraphErrorSuccess;
+}
@@ -0,0 +1,77 @@
+#include "partitioned_graph.h"
+#include <algorithm>
+#include <utility>
+
+//**************************************************************************************************
+// Partition a graph
+//**************************************************************************************************
+GraphError PartitionedGraph::Build(Graph &g, int num_partitions,
+                                   Layout layout) {
+  Graph::VertexListIterator v_it(g);
+  std::vector<std::vector<std::pair<int, int>>> edges;
+
+  if (num_partitions <= 0 || g.V() < 0 ||
+      (layout != kLayout1D && layout != kLayout2D)) {
+    return kGraphErrorBadArgs;
+  }
+
+  num_nodes = g.V();
+  block = std::max(1, (num_nodes + num_partitions - 1) / num_partitions);
+  rows = 1;
+  if (layout == kLayout2D) {
+    for (int r = 1; r * r <= num_partitions; r++) {
+      if (num_partitions % r == 0) {
+        rows = r;
+      }
+    }
+  }
+  cols = num_partitions / rows;
+
+  partitions.assign(num_partitions, GraphPartition());
+  for (int p = 0; p < num_partitions; p++) {
+    GraphPartition &part = partitions[p];
+    part.id = p;
+    part.row = p % rows;
+    part.col = p / rows;
+    part.owned_first = std::min(num_nodes, p * block);
+    part.owned_last = std::min(num_nodes, (p + 1) * block);
+    // Column major numbering keeps the owned blocks of a column contiguous
+    part.source_first = std::min(num_nodes, part.col * rows * block);
+    part.source_last = std::min(num_nodes, (part.col + 1) * rows * block);
+  }
+
+  // Route every edge to its partition
+  edges.resize(num_partitions);
+  for (v_it.begin(); !v_it.end(); ++v_it) {
+    const Vertex *v = v_it.getVertex();
+    Graph::EdgeListIterator e_it(g, v);
+    for (e_it.begin(); !e_it.end(); ++e_it) {
+      int u = v->getId();
+      int w = e_it.getEdge()->getVertex()->getId();
+      edges[At(Owner(w) % rows, Owner(u) / rows)].push_back(
+          std::make_pair(u, w));
+    }
+  }
+
+  // Local CSR over the source range of each partition
+  for (int p = 0; p < num_partitions; p++) {
+    GraphPartition &part = partitions[p];
+    int num_sources = part.source_last - part.source_first;
+    std::vector<uint64_t> fill;
+
+    part.offsets.assign(num_sources + 1, 0);
+    for (auto &e : edges[p]) {
+      part.offsets[e.first - part.source_first + 1]++;
+    }
+    for (int i = 0; i < num_sources; i++) {
+      part.offsets[i + 1] += part.offsets[i];
+    }
+    part.targets.resize(edges[p].size());
+    fill.assign(part.offsets.begin(), part.offsets.end() - 1);
+    for (auto &e : edges[p]) {
+      part.targets[fill[e.first - part.source_first]++] = e.second;
+    }
+    std::vector<std::pair<int, int>>().swap(edges[p]);
+  }
+  return kGraphErrorSuccess;
+}
@@ -0,0 +1,233 @@
+#include "profiler.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//**************************************************************************************************
+// Open the counters, each on its own so one missing event does not take the
+// others down
+//**************************************************************************************************
+PerfCounters::PerfCounters() {
+#if defined(__linux__)
+  static const uint64_t configs[kNumEvents] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+  for (int e = 0; e < kNumEvents; e++) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = configs[e];
+    // user space only, allowed up to perf_event_paranoid 2
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    fds[e] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fds[e] < 0 && error.empty()) {
+      error = std::string("perf_event_open(") + EventName((Event)e) +
+              "): " + strerror(errno);
+    }
+  }
+#else
+  for (int e = 0; e < kNumEvents; e++) {
+    fds[e] = -1;
+  }
+  error = "hardware counters not supported on this platform";
+#endif
+}
+
+//**************************************************************************************************
+// Close the counters
+//**************************************************************************************************
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+  for (int e = 0; e < kNumEvents; e++) {
+    if (fds[e] >= 0) {
+      close(fds[e]);
+    }
+  }
+#endif
+}
+
+//**************************************************************************************************
+// At least one counter is usable
+//**************************************************************************************************
+bool PerfCounters::AnyAvailable() {
+  for (int e = 0; e < kNumEvents; e++) {
+    if (fds[e] >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//**************************************************************************************************
+// Current counts
+//**************************************************************************************************
+void PerfCounters::Read(Sample *out) {
+  for (int e = 0; e < kNumEvents; e++) {
+    out->value[e] = 0;
+    out->valid[e] = false;
+#if defined(__linux__)
+    // value, time enabled, time running
+    uint64_t buf[3];
+
+    if (fds[e] < 0 || read(fds[e], buf, sizeof(buf)) != sizeof(buf)) {
+      continue;
+    }
+    out->valid[e] = true;
+    if (buf[2] && buf[2] < buf[1]) {
+      out->value[e] = (uint64_t)((double)buf[0] * buf[1] / buf[2]);
+    } else {
+      out->value[e] = buf[0];
+    }
+#endif
+  }
+}
+
+//**************************************************************************************************
+// Name of an event, for reporting
+//**************************************************************************************************
+const char *PerfCounters::EventName(Event e) {
+  switch (e) {
+  case kEventCycles:
+    return "cycles";
+  case kEventInstructions:
+    return "instructions";
+  case kEventLlcMisses:
+    return "llc-misses";
+  case kEventBranchMisses:
+    return "branch-misses";
+  default:
+    return "unknown";
+  }
+}
+
+//**************************************************************************************************
+// Start timing a phase, nothing to do without a profiler
+//**************************************************************************************************
+Profiler::Scope::Scope(Profiler *p, const char *name) : prof(p), phase(0) {
+  if (!prof) {
+    return;
+  }
+  phase = prof->GetPhase(name);
+  prof->counters.Read(&start);
+  start_time = std::chrono::steady_clock::now();
+}
+
+//**************************************************************************************************
+// Stop timing and add the deltas to the phase
+//**************************************************************************************************
+Profiler::Scope::~Scope() {
+  PerfCounters::Sample end;
+
+  if (!prof) {
+    return;
+  }
+  auto end_time = std::chrono::steady_clock::now();
+  prof->counters.Read(&end);
+
+  PhaseStats &s = prof->phases[phase];
+  s.calls++;
+  s.seconds += std::chrono::duration<double>(end_time - start_time).count();
+  for (int e = 0; e < PerfCounters::kNumEvents; e++) {
+    if (!start.valid[e] || !end.valid[e]) {
+      s.valid[e] = false;
+    } else if (end.value[e] > start.value[e]) {
+      s.counters[e] += end.value[e] - start.value[e];
+    }
+  }
+}
+
+//**************************************************************************************************
+// Index of a phase, added on first use
+//**************************************************************************************************
+size_t Profiler::GetPhase(const char *name) {
+  for (size_t i = 0; i < phases.size(); i++) {
+    if (phases[i].name == name) {
+      return i;
+    }
+  }
+
+  PhaseStats s;
+  s.name = name;
+  s.calls = 0;
+  s.seconds = 0;
+  for (int e = 0; e < PerfCounters::kNumEvents; e++) {
+    s.counters[e] = 0;
+    s.valid[e] = counters.Available((PerfCounters::Event)e);
+  }
+  phases.push_back(s);
+  return phases.size() - 1;
+}
+
+//**************************************************************************************************
+// Counter value, or n/a
+//**************************************************************************************************
+static std::string FormatCount(const Profiler::PhaseStats &s,
+                               PerfCounters::Event e) {
+  return s.valid[e] ? std::to_string(s.counters[e]) : "n/a";
+}
+
+//**************************************************************************************************
+// a / b, or n/a when either is unavailable
+//**************************************************************************************************
+static std::string FormatRatio(const Profiler::PhaseStats &s,
+                               PerfCounters::Event a, PerfCounters::Event b,
+                               double scale) {
+  std::ostringstream os;
+
+  if (!s.valid[a] || !s.valid[b] || !s.counters[b]) {
+    return "n/a";
+  }
+  os << std::fixed << std::setprecision(2)
+     << scale * s.counters[a] / s.counters[b];
+  return os.str();
+}
+
+//**************************************************************************************************
+// Per phase summary
+//**************************************************************************************************
+void Profiler::Report(std::ostream &os) {
+  if (!counters.AnyAvailable()) {
+    os << "Hardware counters unavailable (" << counters.Error()
+       << "), reporting time only" << std::endl;
+  } else if (!counters.Error().empty()) {
+    os << "Some hardware counters unavailable (" << counters.Error() << ")"
+       << std::endl;
+  }
+
+  os << std::left << std::setw(16) << "PHASE" << std::right << std::setw(8)
+     << "CALLS" << std::setw(12) << "SECONDS" << std::setw(14) << "CYCLES"
+     << std::setw(14) << "INSTR" << std::setw(7) << "IPC" << std::setw(12)
+     << "LLC-MISS" << std::setw(9) << "LLC/KI" << std::setw(12) << "BR-MISS"
+     << std::setw(8) << "BR/KI" << std::endl;
+  for (auto &s : phases) {
+    os << std::left << std::setw(16) << s.name << std::right << std::setw(8)
+       << s.calls << std::setw(12) << std::fixed << std::setprecision(6)
+       << s.seconds << std::setw(14)
+       << FormatCount(s, PerfCounters::kEventCycles) << std::setw(14)
+       << FormatCount(s, PerfCounters::kEventInstructions) << std::setw(7)
+       << FormatRatio(s, PerfCounters::kEventInstructions,
+                      PerfCounters::kEventCycles, 1)
+       << std::setw(12) << FormatCount(s, PerfCounters::kEventLlcMisses)
+       << std::setw(9)
+       << FormatRatio(s, PerfCounters::kEventLlcMisses,
+                      PerfCounters::kEventInstructions, 1000)
+       << std::setw(12) << FormatCount(s, PerfCounters::kEventBranchMisses)
+       << std::setw(8)
+       << FormatRatio(s, PerfCounters::kEventBranchMisses,
+                      PerfCounters::kEventInstructions, 1000)
+       << std::endl;
+  }
+  os.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,31 @@
+#include "spmv.h"
+#include "simd_gather.h"
+
+//**************************************************************************************************
+// Gather product
+//**************************************************************************************************
+void Spmv::Pull(const CsrGraph &a, const double *x, double *y,
+                TaskScheduler &sched) {
+  sched.ParallelFor(0, a.V(), kRowGrain, [&](size_t lo, size_t hi) {
+    for (size_t v = lo; v < hi; v++) {
+      y[v] = SimdGather::GatherSum(x, a.NeighborsBegin(v), a.Degree(v));
+    }
+  });
+}
+
+//**************************************************************************************************
+// Scatter product
+//**************************************************************************************************
+void Spmv::Push(const CsrGraph &a, const double *x, std::atomic<double> *y,
+                TaskScheduler &sched) {
+  sched.ParallelFor(0, a.V(), kRowGrain, [&](size_t lo, size_t hi) {
+    for (size_t u = lo; u < hi; u++) {
+      if (!x[u]) {
+        continue;
+      }
+      for (const int *v = a.NeighborsBegin(u); v != a.NeighborsEnd(u); ++v) {
+        AtomicAdd(y[*v], x[u]);
+      }
+    }
+  });
+}
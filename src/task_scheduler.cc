@@ -0,0 +1,196 @@
+#include "task_scheduler.h"
+#include <chrono>
+
+//**************************************************************************************************
+// Globals
+//**************************************************************************************************
+// Scheduler and deque owned by the current thread, if it is a worker
+static thread_local TaskScheduler *tCurrentScheduler = nullptr;
+static thread_local unsigned tCurrentQueue = 0;
+
+//**************************************************************************************************
+// Queue a task as part of the group
+//**************************************************************************************************
+void TaskScheduler::TaskGroup::Submit(Task task) {
+  pending++;
+  sched.Push(QueuedTask{std::move(task), this});
+}
+
+//**************************************************************************************************
+// Account for a finished task and wake up the waiter on the last one. The
+// count drops under the lock so the group outlives the notification.
+//**************************************************************************************************
+void TaskScheduler::TaskGroup::TaskDone() {
+  std::lock_guard<std::mutex> guard(done_lock);
+  if (--pending == 0) {
+    done.notify_all();
+  }
+}
+
+//**************************************************************************************************
+// Wait for group completion, helping out with queued work in the meantime
+//**************************************************************************************************
+void TaskScheduler::TaskGroup::Wait() {
+  while (pending > 0) {
+    if (sched.RunOne()) {
+      continue;
+    }
+    // Nothing to steal, the remaining tasks are running elsewhere. Sleep
+    // briefly so newly spawned subtasks still get picked up by this thread.
+    std::unique_lock<std::mutex> guard(done_lock);
+    done.wait_for(guard, std::chrono::milliseconds(1),
+                  [this] { return pending == 0; });
+  }
+  // The last TaskDone() may still hold the lock, the group is about to go
+  std::lock_guard<std::mutex> guard(done_lock);
+}
+
+//**************************************************************************************************
+// Construct scheduler and start worker threads
+//**************************************************************************************************
+TaskScheduler::TaskScheduler(unsigned num_workers)
+    : queued(0), next_queue(0), stop(false) {
+  if (!num_workers) {
+    num_workers = std::thread::hardware_concurrency();
+  }
+  if (!num_workers) {
+    num_workers = 1;
+  }
+
+  for (unsigned i = 0; i < num_workers; i++) {
+    queues.emplace_back(new WorkQueue());
+  }
+  for (unsigned i = 0; i < num_workers; i++) {
+    workers.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+  }
+}
+
+//**************************************************************************************************
+// Destructor, drains remaining work and joins workers
+//**************************************************************************************************
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> guard(sleep_lock);
+    stop = true;
+  }
+  wake.notify_all();
+  for (auto &t : workers) {
+    t.join();
+  }
+}
+
+//**************************************************************************************************
+// Push task on the deque of the calling worker, or round robin if called from
+// outside the pool
+//**************************************************************************************************
+void TaskScheduler::Push(QueuedTask &&t) {
+  unsigned idx;
+
+  if (tCurrentScheduler == this) {
+    idx = tCurrentQueue;
+  } else {
+    idx = next_queue++ % queues.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(queues[idx]->lock);
+    queues[idx]->tasks.push_back(std::move(t));
+  }
+  queued++;
+
+  std::lock_guard<std::mutex> guard(sleep_lock);
+  wake.notify_one();
+}
+
+//**************************************************************************************************
+// Take newest task from own deque, otherwise steal the oldest from a victim
+//**************************************************************************************************
+bool TaskScheduler::Pop(QueuedTask &out) {
+  unsigned n = queues.size();
+  unsigned self = (tCurrentScheduler == this) ? tCurrentQueue : next_queue % n;
+
+  if (queued <= 0) {
+    return false;
+  }
+
+  if (tCurrentScheduler == this) {
+    WorkQueue &q = *queues[self];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (!q.tasks.empty()) {
+      out = std::move(q.tasks.back());
+      q.tasks.pop_back();
+      queued--;
+      return true;
+    }
+  }
+
+  for (unsigned i = 0; i < n; i++) {
+    WorkQueue &q = *queues[(self + i) % n];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (!q.tasks.empty()) {
+      out = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      queued--;
+      return true;
+    }
+  }
+  return false;
+}
+
+//**************************************************************************************************
+// Run a single queued task if there is any
+//**************************************************************************************************
+bool TaskScheduler::RunOne() {
+  QueuedTask t;
+
+  if (!Pop(t)) {
+    return false;
+  }
+  t.fn();
+  t.group->TaskDone();
+  return true;
+}
+
+//**************************************************************************************************
+// Worker thread body
+//**************************************************************************************************
+void TaskScheduler::WorkerLoop(unsigned idx) {
+  tCurrentScheduler = this;
+  tCurrentQueue = idx;
+
+  while (true) {
+    if (RunOne()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(sleep_lock);
+    wake.wait(guard, [this] { return stop || queued > 0; });
+    if (stop && queued <= 0) {
+      break;
+    }
+  }
+}
+
+//**************************************************************************************************
+// Run fn over [begin, end) in chunks of grain items
+//**************************************************************************************************
+void TaskScheduler::ParallelFor(size_t begin, size_t end, size_t grain,
+                                const std::function<void(size_t, size_t)> &fn) {
+  if (!grain) {
+    grain = 1;
+  }
+  if (end <= begin) {
+    return;
+  }
+  // Not worth a round trip through the deques
+  if (end - begin <= grain) {
+    fn(begin, end);
+    return;
+  }
+
+  TaskGroup group(*this);
+  for (size_t lo = begin; lo < end; lo += grain) {
+    size_t hi = (end - lo > grain) ? lo + grain : end;
+    group.Submit([&fn, lo, hi] { fn(lo, hi); });
+  }
+  group.Wait();
+}